@@ -11,10 +11,13 @@ namespace Bess::Common {
         class UUIDGenerator {
           public:
             UUIDGenerator();
+            UUIDGenerator(const UUIDGenerator &) = delete;
 
             uuids::uuid getUUID();
 
           private:
+            // seeded once, the uuid generator only keeps a pointer to it
+            std::mt19937 m_engine;
             uuids::uuid_random_generator m_gen;
         };
 
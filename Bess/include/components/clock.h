@@ -11,7 +11,6 @@ namespace Bess::Simulator::Components {
         void render() override;
         void generate(const glm::vec3 &pos) override;
         void deleteComponent() override;
-        void update();
 
         void drawProperties() override;
 
@@ -21,13 +20,18 @@ namespace Bess::Simulator::Components {
         void setFrequency(float frequency);
         float getFrequency();
 
+        void setFrequencyUnit(FrequencyUnit unit);
+        FrequencyUnit getFrequencyUnit();
+
       private:
         float m_frequency;
         uuids::uuid m_outputSlotId;
 
         FrequencyUnit m_frequencyUnit = FrequencyUnit::hertz;
 
-        float m_prevUpdateTime = 0.f;
+        double getFrequencyInHertz() const;
+        // the edges are scheduled by the simulation engine in simulated time
+        void updateNetlistFrequency();
 
         void onLeftClick(const glm::vec2& pos);
     };
@@ -1,4 +1,5 @@
 #pragma once
+#include "components_manager/component_store.h"
 #include "components_manager/component_type.h"
 #include "ext/vector_float2.hpp"
 #include "ext/vector_float3.hpp"
@@ -7,6 +8,7 @@
 #include "uuid.h"
 
 #include <any>
+#include <cassert>
 #include <functional>
 #include <queue>
 #include <unordered_map>
@@ -39,9 +41,11 @@ namespace Bess::Simulator::Components {
 
     class Component {
       public:
-        Component() = default;
+        Component();
         Component(const uuids::uuid &uid, int renderId, glm::vec3 position, ComponentType type);
-        virtual ~Component() = default;
+        Component(const Component &) = delete;
+        Component &operator=(const Component &) = delete;
+        virtual ~Component();
 
         uuids::uuid getId() const;
         std::string getIdStr() const;
@@ -53,6 +57,11 @@ namespace Bess::Simulator::Components {
         ComponentType
         getType() const;
 
+        ComponentHandle getHandle() const;
+
+        bool isSelected() const;
+        bool isHovered() const;
+
         void onEvent(ComponentEventData e);
 
         virtual void render() = 0;
@@ -68,19 +77,39 @@ namespace Bess::Simulator::Components {
 
         virtual void drawProperties();
 
+        // input or output slots, in the order their labels are numbered
+        virtual std::vector<uuids::uuid> getSlots(ComponentType slotType) const;
+        virtual std::string getSlotLabel(ComponentType slotType, int index) const;
+
         virtual void simulate();
 
       protected:
+        // Position, scale and rotation live in the component store. The entry
+        // is cached and kept up to date by the store, the handle is only
+        // checked in debug builds.
+        Scene::Transform::Transform2D &transform() {
+            assert(ComponentStore::isValid(m_handle));
+            return m_archetype->transforms[m_storeIndex];
+        }
+
+        const Scene::Transform::Transform2D &transform() const {
+            assert(ComponentStore::isValid(m_handle));
+            return m_archetype->transforms[m_storeIndex];
+        }
+
         int m_renderId{};
         uuids::uuid m_uid;
         ComponentType m_type = ComponentType::none;
         std::string m_name = "Unknown";
         std::unordered_map<ComponentEventType, std::any> m_events = {};
-        bool m_isSelected = false;
-        bool m_isHovered = false;
-        Scene::Transform::Transform2D m_transform{};
+        ComponentHandle m_handle{};
 
       private:
+        friend class Simulator::ComponentStore;
+
+        ComponentStore::Archetype *m_archetype = nullptr;
+        uint32_t m_storeIndex = 0;
+
         std::queue<ComponentEventData> m_eventsQueue = {};
     };
 } // namespace Bess::Simulator::Components
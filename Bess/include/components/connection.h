@@ -23,6 +23,8 @@ namespace Bess::Simulator::Components {
         void deleteComponent() override;
 
         static uuids::uuid generate(const uuids::uuid &slot1, const uuids::uuid &slot2, const glm::vec3 &pos = {0.f, 0.f, 0.f});
+        // wires the slots again with a connection that was deleted, keeping its id
+        static void restore(const uuids::uuid &uid, const uuids::uuid &slot1, const uuids::uuid &slot2);
         void generate(const glm::vec3 &pos = {0.f, 0.f, 0.f}) override;
 
         void drawProperties() override;
@@ -30,6 +32,7 @@ namespace Bess::Simulator::Components {
         const std::vector<uuids::uuid> &getPoints();
         void setPoints(const std::vector<glm::vec3> &points);
         void addPoint(const uuids::uuid &point);
+        void insertPoint(const uuids::uuid &point, size_t index);
         void removePoint(const uuids::uuid &point);
         void renderCurveConnection(glm::vec3 startPos, glm::vec3 endPos, float weight, glm::vec4 color);
         void renderStraightConnection(glm::vec3 startPos, glm::vec3 endPos, float weight, glm::vec4 color);
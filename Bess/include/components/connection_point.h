@@ -31,5 +31,7 @@ namespace Bess::Simulator::Components {
 
       private:
         uuids::uuid m_parentId;
+        // drawn as selected while its connection is selected
+        bool m_connectionSelected = false;
     };
 } // namespace Bess::Simulator::Components
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "flip_flop.h"
+
+namespace Bess::Simulator::Components {
+    // N-bit up/down counter, counts on the clock edge while EN is high,
+    // down while DOWN is high, RST clears it on the edge
+    class Counter : public FlipFlop {
+      public:
+        static constexpr char name[] = "Counter";
+        static constexpr int defaultWidth = 8;
+
+        Counter(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots);
+        Counter(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, std::vector<uuids::uuid> outputSlots, uuids::uuid clockSlot);
+        Counter() = default;
+
+        void generate(const glm::vec3 &pos = {0.f, 0.f, 0.f}) override;
+
+        void drawProperties() override;
+        nlohmann::json toJson() override;
+
+        int getWidth() const;
+        void setWidth(int width);
+
+      protected:
+        std::string getInputLabel(int index) const override;
+        std::string getOutputLabel(int index) const override;
+    };
+} // namespace Bess::Simulator::Components
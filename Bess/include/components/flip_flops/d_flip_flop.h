@@ -7,6 +7,7 @@ namespace Bess::Simulator::Components {
       public:
         static constexpr char name[] = "D Flip Flop";
         DFlipFlop(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots);
+        DFlipFlop(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, std::vector<uuids::uuid> outputSlots, uuids::uuid clockSlot);
         DFlipFlop() = default;
 
         void update() override;
@@ -14,7 +15,5 @@ namespace Bess::Simulator::Components {
         void generate(const glm::vec3 &pos = {0.f, 0.f, 0.f}) override;
 
         void drawProperties() override;
-
-        void simulate() override;
     };
 } // namespace Bess::Simulator::Components
@@ -5,13 +5,17 @@
 #include "components/slot.h"
 #include "components_manager/components_manager.h"
 #include "json.hpp"
+#include "simulator/netlist.h"
 #include "uuid.h"
 
 namespace Bess::Simulator::Components {
 
     class FlipFlop : public Component {
       public:
-        FlipFlop(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots);
+        // registers hold their bits in one word
+        static constexpr int maxWidth = 64;
+
+        FlipFlop(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, int outputCount = 2);
         FlipFlop(const uuids::uuid &uid, int renderId, const glm::vec3 &position, const std::vector<uuids::uuid> &inputSlots, const std::string &name, const std::vector<uuids::uuid> &outputSlots, const uuids::uuid &clockSlot);
 
         FlipFlop() = default;
@@ -53,15 +57,40 @@ namespace Bess::Simulator::Components {
 
         void drawProperties() override = 0;
 
-        void simulate() override = 0;
-
         static void fromJson(const nlohmann::json &data);
 
-        nlohmann::json toJson();
+        // registers add their size, loading takes it from the slots
+        virtual nlohmann::json toJson();
+
+        // edge of the clock the flip flop is triggered on
+        ClockEdge getClockEdge() const;
+        void setClockEdge(ClockEdge edge);
+
+        // the clock slot comes after the other inputs
+        std::vector<uuids::uuid> getSlots(ComponentType slotType) const override;
+        std::string getSlotLabel(ComponentType slotType, int index) const override;
 
       protected:
+        // registers the flip flop and its slots in the simulation netlist
+        void addToNetlist(NodeKind kind);
+
+        // combo box shared by the properties of all flip flops
+        void drawClockEdgeProperty();
+
+        // Keeps the first `count` of `slots`, the others are deleted with
+        // their wires, or adds new ones. The node has to be added to the
+        // netlist again afterwards.
+        std::vector<uuids::uuid> resizeSlots(const std::vector<uuids::uuid> &slots, int count, ComponentType type);
+
+        // number input of the registers, true once it changed `width`
+        bool drawWidthProperty(const char *label, int &width, int min, int max);
+
+        virtual std::string getInputLabel(int index) const;
+        virtual std::string getOutputLabel(int index) const;
+
         std::vector<uuids::uuid> m_inputSlots;
         std::vector<uuids::uuid> m_outputSlots;
         uuids::uuid m_clockSlot;
+        ClockEdge m_clockEdge = ClockEdge::rising;
     };
 } // namespace Bess::Simulator::Components
@@ -1,2 +1,6 @@
+#include "counter.h"
 #include "d_flip_flop.h"
+#include "d_register.h"
 #include "jk_flip_flop.h"
+#include "register_file.h"
+#include "shift_register.h"
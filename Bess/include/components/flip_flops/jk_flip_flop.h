@@ -15,7 +15,5 @@ namespace Bess::Simulator::Components {
         void generate(const glm::vec3 &pos = {0.f, 0.f, 0.f}) override;
 
         void drawProperties() override;
-
-        void simulate() override;
     };
 } // namespace Bess::Simulator::Components
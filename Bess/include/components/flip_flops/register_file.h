@@ -0,0 +1,32 @@
+#pragma once
+
+#include "flip_flop.h"
+
+namespace Bess::Simulator::Components {
+    // 2^a words of N bits. D is written at WA on the clock edge while WE is
+    // high, Q always shows the word at RA.
+    class RegisterFile : public FlipFlop {
+      public:
+        static constexpr char name[] = "Register File";
+        static constexpr int defaultWidth = 8;
+        static constexpr int defaultAddressBits = 2;
+        static constexpr int maxAddressBits = 8;
+
+        RegisterFile(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots);
+        RegisterFile(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, std::vector<uuids::uuid> outputSlots, uuids::uuid clockSlot);
+        RegisterFile() = default;
+
+        void generate(const glm::vec3 &pos = {0.f, 0.f, 0.f}) override;
+
+        void drawProperties() override;
+        nlohmann::json toJson() override;
+
+        int getWidth() const;
+        int getAddressBits() const;
+        void resize(int width, int addressBits);
+
+      protected:
+        std::string getInputLabel(int index) const override;
+        std::string getOutputLabel(int index) const override;
+    };
+} // namespace Bess::Simulator::Components
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "flip_flop.h"
+
+namespace Bess::Simulator::Components {
+    // N-bit shift register, shifts SI in at Q0 on the clock edge while EN is high
+    class ShiftRegister : public FlipFlop {
+      public:
+        static constexpr char name[] = "Shift Register";
+        static constexpr int defaultWidth = 8;
+
+        ShiftRegister(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots);
+        ShiftRegister(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, std::vector<uuids::uuid> outputSlots, uuids::uuid clockSlot);
+        ShiftRegister() = default;
+
+        void generate(const glm::vec3 &pos = {0.f, 0.f, 0.f}) override;
+
+        void drawProperties() override;
+        nlohmann::json toJson() override;
+
+        int getWidth() const;
+        void setWidth(int width);
+
+      protected:
+        std::string getInputLabel(int index) const override;
+        std::string getOutputLabel(int index) const override;
+    };
+} // namespace Bess::Simulator::Components
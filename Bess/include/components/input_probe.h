@@ -17,17 +17,20 @@ namespace Bess::Simulator::Components {
         void deleteComponent() override;
 
         void generate(const glm::vec3& pos = { 0.f, 0.f, 0.f }) override;
+        void drawProperties() override;
 
         nlohmann::json toJson();
+        const uuids::uuid& getOutputSlot() const;
 
-        static void fromJson(const nlohmann::json& data);
-
-        void simulate() const;
+        // names the probe in test vectors, empty until the user sets one
+        const std::string& getLabel() const;
+        void setLabel(const std::string& label);
 
-        void refresh() const;
+        static void fromJson(const nlohmann::json& data);
 
     private:
         uuids::uuid m_outputSlot;
+        std::string m_label = "";
 
         void onLeftClick(const glm::vec2& pos);
     };
@@ -18,7 +18,6 @@ namespace Bess::Simulator::Components {
 
         void render() override;
 
-        void simulate() override;
 
         void generate(const glm::vec3 &pos = {0.f, 0.f, 0.f}) override;
 
@@ -30,6 +29,15 @@ namespace Bess::Simulator::Components {
 
         static void fromJson(const nlohmann::json &data);
 
+        const std::shared_ptr<JComponentData> &getData() const;
+
+        const std::vector<uuids::uuid> &getInputSlots() const;
+
+        const std::vector<uuids::uuid> &getOutputSlots() const;
+
+        std::vector<uuids::uuid> getSlots(ComponentType slotType) const override;
+        std::string getSlotLabel(ComponentType slotType, int index) const override;
+
       private:
         std::vector<uuids::uuid> m_inputSlots;
         std::vector<uuids::uuid> m_outputSlots;
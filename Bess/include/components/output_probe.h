@@ -17,12 +17,19 @@ class OutputProbe : public Component {
     void deleteComponent() override;
 
     void generate(const glm::vec3& pos = { 0.f, 0.f, 0.f }) override;
+    void drawProperties() override;
 
     nlohmann::json toJson();
+    const uuids::uuid &getInputSlot() const;
+
+    // names the probe in test vectors, empty until the user sets one
+    const std::string &getLabel() const;
+    void setLabel(const std::string &label);
 
     static void fromJson(const nlohmann::json& data);
 
   private:
     uuids::uuid m_inputSlot;
+    std::string m_label = "";
 };
 } // namespace Bess::Simulator::Components
@@ -19,7 +19,6 @@ namespace Bess::Simulator::Components {
 
         void deleteComponent() override;
 
-        void addConnection(const uuids::uuid& uId, bool simulate = true);
         bool isConnectedTo(const uuids::uuid& uId);
 
         void highlightBorder(bool highlight = true);
@@ -27,7 +26,11 @@ namespace Bess::Simulator::Components {
         Simulator::DigitalState getState() const;
         DigitalState flipState();
 
-        void setState(const uuids::uuid& uid, Simulator::DigitalState state, bool forceUpdate = false);
+        int getPinId() const;
+
+        // bits carried by the slot, more than one for bus slots
+        int getWidth() const;
+        void setWidth(int width);
 
         const uuids::uuid& getParentId();
 
@@ -43,34 +46,26 @@ namespace Bess::Simulator::Components {
         const glm::vec2& getLabelOffset();
         void setLabelOffset(const glm::vec2& label);
 
-        const std::vector<uuids::uuid>& getConnections();
-
-        // uid of component making change
-        void simulate(const uuids::uuid& uid, DigitalState state);
-
-        void refresh(const uuids::uuid& uid, DigitalState state);
-
-        void removeConnection(const uuids::uuid& uid);
+        // ids of the slots wired to this one
+        std::vector<uuids::uuid> getConnections();
 
     private:
-        // contains ids of slots
-        std::vector<uuids::uuid> m_connections;
         bool m_highlightBorder = false;
         void onLeftClick(const glm::vec2& pos);
         void onMouseHover();
 
         // slot specific
         const uuids::uuid m_parentUid;
-        Simulator::DigitalState m_state;
 
-        void onChange();
+        // index of the slot in the simulation netlist, looked up once the
+        // command that added the pin was applied
+        mutable int m_pinId = -1;
+        uint64_t m_pinCommand = 0;
 
-        std::unordered_map<uuids::uuid, bool> m_stateChangeHistory = {};
+        int m_width = 1;
 
         std::string m_label = "";
         glm::vec2 m_labelOffset = { 0.f, 0.f };
         float m_labelWidth = 0.f;
-
-        float m_deleting = false;
     };
 } // namespace Bess::Simulator::Components
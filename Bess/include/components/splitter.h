@@ -0,0 +1,43 @@
+#pragma once
+
+#include "component.h"
+#include "json.hpp"
+#include "uuid.h"
+#include <vector>
+
+namespace Bess::Simulator::Components {
+    // Splits a bus slot into one slot per bit (ComponentType::splitter) or
+    // merges bit slots into a bus slot (ComponentType::merger). Bit 0 is the
+    // least significant bit of the bus word.
+    class Splitter : public Component {
+      public:
+        static constexpr char splitterName[] = "Splitter";
+        static constexpr char mergerName[] = "Merger";
+        // widths offered in the component bank
+        static constexpr int bankWidths[] = {4, 8, 16, 32};
+
+        Splitter() = default;
+        Splitter(const uuids::uuid &uid, int renderId, glm::vec3 position, ComponentType type,
+                 const uuids::uuid &busSlot, const std::vector<uuids::uuid> &bitSlots);
+
+        void render() override;
+        void generate(const glm::vec3 &pos = {0.f, 0.f, 0.f}) override;
+        void generate(ComponentType type, int width, const glm::vec3 &pos = {0.f, 0.f, 0.f});
+        void deleteComponent() override;
+
+        void drawProperties() override;
+
+        static void fromJson(const nlohmann::json &data);
+        nlohmann::json toJson();
+
+        // "8-bit Splitter", the name of the bank element
+        static std::string getBankName(ComponentType type, int width);
+        static int widthFromBankName(const std::string &name);
+
+      private:
+        void drawBackground(const glm::vec4 &borderThicknessPx, float rPx, float headerHeight, const glm::vec2 &gateSize);
+
+        uuids::uuid m_busSlot;
+        std::vector<uuids::uuid> m_bitSlots;
+    };
+} // namespace Bess::Simulator::Components
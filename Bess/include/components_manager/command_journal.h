@@ -0,0 +1,125 @@
+#pragma once
+
+#include "glm.hpp"
+#include "json.hpp"
+#include "uuid.h"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace Bess::Simulator {
+
+    // Undo and redo history of the edits made to the scene. An entry only
+    // keeps what its edit touched: the saved json of the components involved,
+    // the wires attached to them and the positions they moved between, so
+    // undoing or redoing costs as much as the edit itself.
+    class CommandJournal {
+      public:
+        // memory the history may hold before the oldest entries are dropped
+        static constexpr size_t defaultBudget = 32 * 1024 * 1024;
+
+        // property edits of one component closer together than this are undone at once
+        static constexpr std::chrono::milliseconds coalesceWindow{1000};
+
+        // the component or wire was just placed
+        static void recordAdd(const uuids::uuid &uid);
+
+        // the component or wire is about to be deleted
+        static void recordRemove(const uuids::uuid &uid);
+
+        static void recordMove(const uuids::uuid &uid, const glm::vec3 &from, const glm::vec3 &to);
+
+        // saved json of one component before and after its properties were edited
+        static void recordChange(const nlohmann::json &before, const nlohmann::json &after);
+
+        // Edits recorded between these are undone in one step, the moves of a
+        // component inside a group are merged into one. Groups can nest.
+        static void beginGroup();
+        static void endGroup();
+
+        static bool undo();
+        static bool redo();
+
+        static bool canUndo();
+        static bool canRedo();
+
+        static void clear();
+
+        static void setMemoryBudget(size_t bytes);
+        static size_t getMemoryUsage();
+
+      private:
+        // saved state of deleted components and wires
+        struct Snapshot {
+            struct Wire {
+                uuids::uuid uid;
+                uuids::uuid inputSlot = {};
+                uuids::uuid outputSlot = {};
+                std::vector<nlohmann::json> points = {};
+            };
+
+            struct Point {
+                nlohmann::json data;
+                uuids::uuid connection;
+                size_t index;
+            };
+
+            std::vector<nlohmann::json> components;
+            std::vector<Wire> wires;
+            std::vector<Point> points;
+        };
+
+        enum class OperationType {
+            add,
+            remove,
+            move,
+            change
+        };
+
+        struct Operation {
+            OperationType type;
+            uuids::uuid uid;
+            // add: taken when undone, remove: taken when recorded
+            Snapshot snapshot = {};
+            glm::vec3 from = {}, to = {};
+            nlohmann::json before = {}, after = {};
+        };
+
+        struct Command {
+            std::vector<Operation> operations;
+            size_t bytes = 0;
+        };
+
+        static void record(Operation &&operation);
+        // merges the edit into the previous one of the same component if close enough
+        static void recordChange(Operation &&operation);
+        static void push(Command &&command);
+        static void measure(Command &command);
+        static void trim();
+
+        static void undo(Operation &operation);
+        static void redo(Operation &operation);
+
+        static Snapshot capture(const uuids::uuid &uid);
+        static void captureWire(const uuids::uuid &connection, Snapshot &snapshot);
+        static void restore(const Snapshot &snapshot);
+        static void erase(const Snapshot &snapshot);
+        // re-creates the component from its json, keeping its wires
+        static void replace(const nlohmann::json &data);
+
+        // removes the connections listed in the slots of saved json, the
+        // journal keeps them as wires. Returns the slot ids.
+        static std::vector<uuids::uuid> stripConnections(nlohmann::json &data);
+
+        static std::deque<Command> m_undo;
+        static std::vector<Command> m_redo;
+        static Command m_group;
+        static int m_groupDepth;
+        static bool m_replaying;
+        static size_t m_budget;
+        static size_t m_usedBytes;
+        static std::chrono::steady_clock::time_point m_lastChange;
+    };
+} // namespace Bess::Simulator
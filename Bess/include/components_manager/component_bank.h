@@ -37,7 +37,19 @@ namespace Bess::Simulator {
         static void loadFromJson(const std::string& filepath);
         static void loadMultiFromJson(const std::string& filepath);
 
+        // adds a component entry to the bank and appends it to the file of its
+        // collection, a new collection gets its own file in the collections list
+        static void saveToCollection(const std::string& collection, const nlohmann::json& entry);
+
+        // subcircuit entries used by the given components, nested definitions first
+        static nlohmann::json getSubcircuitEntries(const std::vector<std::shared_ptr<Components::JComponentData>>& used);
+        // adds the entries of getSubcircuitEntries() that are not in the bank yet
+        static void loadSubcircuitEntries(const nlohmann::json& entries);
+
     private:
         static BankVault m_vault;
+        // file every collection was loaded from
+        static std::unordered_map<std::string, std::string> m_collectionFiles;
+        static std::string m_collectionsListPath;
     };
 }
\ No newline at end of file
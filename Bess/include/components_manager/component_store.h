@@ -0,0 +1,89 @@
+#pragma once
+
+#include "components_manager/component_type.h"
+#include "scene/transform/transform_2d.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Bess::Simulator::Components {
+    class Component;
+}
+
+namespace Bess::Simulator {
+
+    // Stable reference to a component in the store. Slots are reused after a
+    // component is removed, the generation tells the old handle apart.
+    struct ComponentHandle {
+        static constexpr uint32_t invalidSlot = UINT32_MAX;
+
+        uint32_t slot = invalidSlot;
+        uint32_t generation = 0;
+
+        bool operator==(const ComponentHandle &other) const = default;
+    };
+
+    // Per-frame data of the scene components, packed per component type.
+    // Every type has dense arrays indexed together, a removed entry is
+    // replaced by the last one so walking a type only touches contiguous
+    // memory. The components themselves stay owned by the ComponentsManager,
+    // each one caches its entry and the store updates it when it moves.
+    // Handles are only checked in debug builds.
+    class ComponentStore {
+      public:
+        struct Archetype {
+            std::vector<Components::Component *> objects;
+            std::vector<Scene::Transform::Transform2D> transforms;
+            std::vector<uint8_t> flags;
+            // handle slot of every entry, to patch the slot table after a move
+            std::vector<uint32_t> slots;
+
+            size_t size() const;
+        };
+
+        static constexpr uint8_t selectedFlag = 1;
+        static constexpr uint8_t hoveredFlag = 2;
+
+        static ComponentHandle add(Components::Component *object, ComponentType type);
+        static void remove(ComponentHandle handle);
+        static bool isValid(ComponentHandle handle);
+
+        static Scene::Transform::Transform2D &getTransform(ComponentHandle handle);
+
+        static bool hasFlag(ComponentHandle handle, uint8_t flag);
+        static void setFlag(ComponentHandle handle, uint8_t flag, bool value);
+
+        static Archetype &getArchetype(ComponentType type);
+
+        // every type a scene component can have
+        static const std::vector<ComponentType> &getTypes();
+
+        // types whose components are drawn by the scene, in draw order
+        static const std::vector<ComponentType> &getRenderTypes();
+        static bool isRenderType(ComponentType type);
+
+      private:
+        struct Slot {
+            ComponentType type = ComponentType::none;
+            uint32_t index = 0;
+            uint32_t generation = 0;
+            bool alive = false;
+        };
+
+        static size_t indexOf(ComponentType type);
+        static Slot &getSlot(ComponentHandle handle);
+
+        // the types below 100 and the draggable ones from 101 are contiguous
+        static constexpr size_t typeCount = static_cast<int>(ComponentType::button) + 2 +
+                                            static_cast<int>(ComponentType::merger) - static_cast<int>(ComponentType::jcomponent) + 1;
+
+        struct Storage {
+            std::array<Archetype, typeCount> archetypes;
+            std::vector<Slot> slots;
+            std::vector<uint32_t> freeSlots;
+        };
+
+        static Storage &storage();
+    };
+} // namespace Bess::Simulator
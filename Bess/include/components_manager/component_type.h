@@ -14,7 +14,9 @@ namespace Bess::Simulator {
         text,
         connectionPoint,
         clock,
-        flipFlop
+        flipFlop,
+        splitter,
+        merger
     };
 
     enum class FrequencyUnit {
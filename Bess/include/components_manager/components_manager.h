@@ -5,6 +5,8 @@
 
 #include "components/component.h"
 #include "components_manager/component_bank.h"
+#include "components_manager/connection_index.h"
+#include "json.hpp"
 #include "uuid.h"
 
 #include <memory>
@@ -24,12 +26,41 @@ namespace Bess::Simulator {
         // scene.
         static std::vector<uuids::uuid> renderComponents;
 
-        static void generateComponent(const ComponentBankElement &comp, const glm::vec3 &pos = {0.f, 0.f, 0.f});
+        // the generate functions return the id of the placed component
+        static uuids::uuid generateComponent(const ComponentBankElement &comp, const glm::vec3 &pos = {0.f, 0.f, 0.f});
 
-        static void generateComponent(ComponentType type, const std::any &data = NULL, const glm::vec3 &pos = {0.f, 0.f, 0.f});
+        static uuids::uuid generateComponent(ComponentType type, const std::any &data = NULL, const glm::vec3 &pos = {0.f, 0.f, 0.f});
+
+        // pins of neighbouring array elements to wire together, by slot label
+        // or 0-based index
+        struct ArrayLink {
+            std::string output;
+            std::string input;
+        };
+
+        // Places `rows` x `cols` copies of the bank element, `spacing` apart
+        // from `pos`, and wires every link from an element to the next one in
+        // its row. Returns the placed components row by row.
+        static std::vector<uuids::uuid> generateArray(const ComponentBankElement &comp, int rows, int cols,
+                                                      const glm::vec3 &pos, const glm::vec2 &spacing,
+                                                      const std::vector<ArrayLink> &links = {});
+
+        // slot of the component by its label or 0-based index, `slotType`
+        // picks inputs or outputs. Throws when the component has no such slot.
+        static uuids::uuid findSlot(const uuids::uuid &component, const std::string &pin, ComponentType slotType);
+
+        // makes room in the maps for `count` more components, slots included
+        static void reserve(size_t count);
 
         static void deleteComponent(uuids::uuid uid);
 
+        // saved json of the component, null for the ones saved by their parent
+        // and for connection points
+        static nlohmann::json componentToJson(const uuids::uuid &uid);
+
+        // places a component from its saved json, keeping its ids
+        static void componentFromJson(const nlohmann::json &data);
+
         static uuids::uuid addConnection(const uuids::uuid &start, const uuids::uuid &end);
 
         static const uuids::uuid &renderIdToCid(int rId);
@@ -53,7 +84,19 @@ namespace Bess::Simulator {
 
         static void removeSlotsToConn(const uuids::uuid &inpSlot, const uuids::uuid &outSlot);
 
-        static const std::string &getSlotsForConnection(const uuids::uuid &conn);
+        // "input,output" slot ids of the connection, as saved with its points
+        static std::string getSlotsForConnection(const uuids::uuid &conn);
+
+        // {input slot, output slot} of the connection
+        static std::pair<uuids::uuid, uuids::uuid> getConnectionSlots(const uuids::uuid &conn);
+
+        // connections attached to the slot
+        static std::vector<uuids::uuid> getSlotConnections(const uuids::uuid &slot);
+
+        // slots wired to the slot
+        static std::vector<uuids::uuid> getConnectedSlots(const uuids::uuid &slot);
+
+        static bool areSlotsConnected(const uuids::uuid &slotA, const uuids::uuid &slotB);
 
         static float getNextZPos();
 
@@ -70,6 +113,10 @@ namespace Bess::Simulator {
 
         static bool isRenderComponent(int rId);
 
+        // Saves the selected gates as a subcircuit in `collection`. The selected
+        // input and output probes become its ports, ordered top to bottom.
+        static void saveAsSubcircuit(const std::vector<uuids::uuid> &ids, const std::string &collection, const std::string &name);
+
       private:
         // mapping from render id to components id.
         static std::unordered_map<int, uuids::uuid> m_renderIdToCId;
@@ -77,11 +124,14 @@ namespace Bess::Simulator {
         // mapping from component id to render id.
         static std::unordered_map<uuids::uuid, int> m_compIdToRId;
 
-        // mapping for slots and correspondin connection id
-        static std::unordered_map<std::string, uuids::uuid> m_slotsToConn;
+        // slots and the connections between them
+        static ConnectionIndex m_connectionIndex;
 
         static int renderIdCounter;
 
+        // only the deletions asked for are journaled, not what they take along
+        static int m_deleteDepth;
+
         static float zPos;
     };
 } // namespace Bess::Simulator
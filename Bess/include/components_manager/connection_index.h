@@ -0,0 +1,62 @@
+#pragma once
+
+#include "uuid.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Bess::Simulator {
+
+    // Which slots every connection wires together, looked up in both
+    // directions. Slots and connections get compact ids while they are
+    // wired, the slot pair of a connection is a single integer key.
+    class ConnectionIndex {
+      public:
+        void add(const uuids::uuid &inputSlot, const uuids::uuid &outputSlot, const uuids::uuid &connection);
+        void remove(const uuids::uuid &connection);
+        void clear();
+
+        // nil when the slots are not wired together
+        const uuids::uuid &getConnection(const uuids::uuid &inputSlot, const uuids::uuid &outputSlot) const;
+
+        // {input slot, output slot} of the connection
+        std::pair<uuids::uuid, uuids::uuid> getSlots(const uuids::uuid &connection) const;
+
+        std::vector<uuids::uuid> getConnections(const uuids::uuid &slot) const;
+        // slots on the other end of the connections of `slot`
+        std::vector<uuids::uuid> getConnectedSlots(const uuids::uuid &slot) const;
+
+        bool isConnected(const uuids::uuid &slotA, const uuids::uuid &slotB) const;
+
+      private:
+        struct Pin {
+            uuids::uuid uid;
+            std::vector<uint32_t> wires;
+        };
+
+        struct Wire {
+            uuids::uuid uid;
+            uint32_t input;
+            uint32_t output;
+        };
+
+        static uint64_t pairKey(uint32_t input, uint32_t output);
+
+        uint32_t acquirePin(const uuids::uuid &slot);
+        void releaseWire(uint32_t pin, uint32_t wire);
+        // compact id of the slot, or -1 when it has no connections
+        int64_t findPin(const uuids::uuid &slot) const;
+
+        std::vector<Pin> m_pins = {};
+        std::vector<uint32_t> m_freePins = {};
+        std::unordered_map<uuids::uuid, uint32_t> m_pinIds = {};
+
+        std::vector<Wire> m_wires = {};
+        std::vector<uint32_t> m_freeWires = {};
+        std::unordered_map<uuids::uuid, uint32_t> m_wireIds = {};
+
+        std::unordered_map<uint64_t, uint32_t> m_pairToWire = {};
+    };
+} // namespace Bess::Simulator
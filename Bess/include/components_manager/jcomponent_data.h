@@ -3,10 +3,18 @@
 #include <string>
 #include <vector>
 #include "json.hpp"
+#include "simulator/compiled_expression.h"
+#include "simulator/word_expression.h"
+#include "components_manager/subcircuit_definition.h"
 
 namespace Bess::Simulator::Components {
 	class JComponentData {
 	public:
+		// inputs and outputs are packed into 32 bit words when evaluated
+		static constexpr int maxPorts = 32;
+		// widest bus a port can carry
+		static constexpr int maxWidth = 64;
+
 		JComponentData() = default;
 		JComponentData(const nlohmann::json& json, const std::string& collectionName);
 
@@ -16,12 +24,48 @@ namespace Bess::Simulator::Components {
 
 		const int& getInputCount() const;
 
+		// output expressions, or the output labels of a subcircuit
 		const std::vector<std::string>& getOutputs() const;
 
+		// outputs compiled at load time, indexed like getOutputs(), empty for subcircuits
+		const std::vector<CompiledExpression>& getCompiledOutputs() const;
+
+		bool isSubcircuit() const;
+
+		// Entries with "inputWidths" / "outputWidths" work on bus words, their
+		// outputs are WordExpressions. Ports missing from the lists are one bit.
+		bool isWord() const;
+		int getInputWidth(int input) const;
+		int getOutputWidth(int output) const;
+
+		// one word per port, each output is cut to its width
+		void evaluateWords(const uint64_t* inputs, uint64_t* outputs) const;
+
+		const std::shared_ptr<const SubcircuitDefinition>& getSubcircuit() const;
+
+		// bit i of `inputs` is the state of input i, bit i of the result the
+		// state of output i
+		uint32_t evaluate(uint32_t inputs) const;
+
+		// every bit lane of the words is an independent evaluation
+		void evaluateLanes(const uint64_t* inputs, uint64_t* outputs) const;
+
+		// the bank entry this data was loaded from
+		nlohmann::json toJson() const;
+
+		// propagation delay in ticks, the optional "delay" of the bank entry
+		uint64_t getDelay() const;
+
 	private:
 		std::string m_name = "";
 		std::string m_collectionName = "";
 		int m_inputCount = 0;
 		std::vector<std::string> m_outputs = {};
+		std::vector<CompiledExpression> m_compiledOutputs = {};
+		std::shared_ptr<const SubcircuitDefinition> m_subcircuit = nullptr;
+		std::vector<int> m_inputWidths = {};
+		std::vector<int> m_outputWidths = {};
+		std::vector<WordExpression> m_wordOutputs = {};
+		uint64_t m_delay = 1;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "json.hpp"
+
+namespace Bess::Simulator::Components {
+    class JComponentData;
+
+    // Gates of a saved circuit selection, evaluated as one component. The
+    // definition is compiled once when its collection is loaded and shared by
+    // every instance, an instance only keeps the state of its ports.
+    class SubcircuitDefinition {
+      public:
+        // gate index of a source that is one of the subcircuit inputs
+        static constexpr int inputSource = -1;
+        // definitions with at most this many inputs are answered from a truth table
+        static constexpr int maxTableInputs = 12;
+
+        struct Gate {
+            std::shared_ptr<const JComponentData> data;
+            // signal feeding each gate input, -1 when the input is left open
+            std::vector<int> inputs;
+            // signal of the first gate output, the others follow it
+            int firstOutput;
+        };
+
+        // gates are listed in evaluation order and reference sources as
+        // [gate, output] pairs, so a definition can never contain a loop
+        SubcircuitDefinition(const nlohmann::json &json, int inputCount, int outputCount);
+
+        // bit i of `inputs` is the state of input i, bit i of the result the
+        // state of output i
+        uint32_t evaluate(uint32_t inputs) const;
+
+        // every bit lane of the words is an independent evaluation
+        void evaluateLanes(const uint64_t *inputs, uint64_t *outputs) const;
+
+        // longest path through the gates, in ticks
+        uint64_t getDepth() const;
+
+        const std::vector<Gate> &getGates() const;
+
+        const nlohmann::json &toJson() const;
+
+      private:
+        void runGates(const uint64_t *inputs, uint64_t *outputs) const;
+        void buildTruthTable();
+
+        nlohmann::json m_json;
+        int m_inputCount = 0;
+        int m_signalCount = 0;
+        std::vector<Gate> m_gates = {};
+        // signal driving each output, -1 when the output is left open
+        std::vector<int> m_outputs = {};
+        // packed outputs per input combination
+        std::vector<uint32_t> m_truthTable = {};
+        uint64_t m_depth = 1;
+    };
+} // namespace Bess::Simulator::Components
@@ -30,6 +30,9 @@ namespace Bess::Pages {
         std::shared_ptr<Window> getParentWindow();
 
       private:
+        // world units around the view in which components are still drawn
+        static constexpr float cullMargin = 64.f;
+
         std::shared_ptr<Camera> m_camera;
         std::unique_ptr<Gl::FrameBuffer> m_multiSampledFramebuffer, m_normalFramebuffer;
         std::shared_ptr<Window> m_parentWindow;
@@ -52,6 +55,8 @@ namespace Bess::Pages {
         bool m_leftMousePressed = false;
         bool m_rightMousePressed = false;
         bool m_middleMousePressed = false;
+        // set while a drag holds a journal group open
+        bool m_dragGroupOpen = false;
 
         std::chrono::time_point<std::chrono::steady_clock> m_lastUpdateTime;
 
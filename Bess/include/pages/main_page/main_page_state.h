@@ -76,6 +76,9 @@ namespace Bess::Pages {
       private:
         void addFocusLostEvent(const uuids::uuid &id);
         void addFocusEvent(const uuids::uuid &id);
+        // mirrors the bulk ids and the hovered id into the component store flags
+        void setComponentFlag(const uuids::uuid &id, uint8_t flag, bool value);
+        void setComponentFlag(int renderId, uint8_t flag, bool value);
 
       private:
         // ids of entity hovered by mouse
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "glm.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Bess::Scene {
+
+    // World space shapes of everything drawn with a render id, bucketed in a
+    // uniform grid to answer hover, box selection and culling on the CPU.
+    // The renderer records the shapes while drawing, an id is only moved to
+    // other cells when its shapes differ from the previous frame.
+    class SpatialIndex {
+      public:
+        struct Shape {
+            glm::vec2 center;
+            // half extents of a quad, the radius of a circle in x
+            glm::vec2 halfSize;
+            float angle;
+            float z;
+            bool circle;
+
+            bool operator==(const Shape &other) const = default;
+        };
+
+        static constexpr float cellSize = 64.f;
+
+        static void beginFrame();
+        static void addQuad(int id, const glm::vec3 &center, const glm::vec2 &size, float angle);
+        static void addCircle(int id, const glm::vec3 &center, float radius);
+        static void endFrame();
+
+        static void remove(int id);
+        // the id moved, it is culled again once it has been drawn
+        static void invalidate(int id);
+        static void clear();
+
+        // topmost id under the point, -1 when there is none
+        static int pick(const glm::vec2 &point);
+
+        // ids with a shape overlapping the rectangle
+        static std::vector<int> query(const glm::vec2 &min, const glm::vec2 &max);
+
+        // false only for ids that are indexed, unmoved and outside the rectangle
+        static bool mayBeVisible(int id, const glm::vec2 &min, const glm::vec2 &max);
+
+      private:
+        struct Entry {
+            std::vector<Shape> shapes;
+            std::vector<uint64_t> cells;
+            glm::vec2 min, max;
+            bool dirty = false;
+
+            // shapes recorded in the current frame
+            std::vector<Shape> pending;
+            uint64_t frame = 0;
+        };
+
+        static uint64_t cellKey(int x, int y);
+        static glm::ivec2 cellOf(const glm::vec2 &point);
+        static void bounds(const Shape &shape, glm::vec2 &min, glm::vec2 &max);
+        static bool contains(const Shape &shape, const glm::vec2 &point);
+        static void unlink(int id, Entry &entry);
+        static void link(int id, Entry &entry);
+        static void add(int id, const Shape &shape);
+
+        static std::unordered_map<int, Entry> m_entries;
+        static std::unordered_map<uint64_t, std::vector<int>> m_cells;
+        static std::vector<int> m_drawn;
+        static uint64_t m_frame;
+    };
+} // namespace Bess::Scene
@@ -18,6 +18,8 @@ namespace Bess {
         static glm::vec4 selectionBoxBorderColor;
         static glm::vec4 selectionBoxFillColor;
         static glm::vec4 stateLowColor;
+        // border of the components on an oscillating feedback loop
+        static glm::vec4 oscillatingColor;
         static void updateColorsFromImGuiStyle();
     };
 } // namespace Bess
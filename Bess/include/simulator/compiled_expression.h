@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Bess::Simulator {
+    // Postfix form of a JComponent output expression. It is compiled once when
+    // the component bank is loaded and shared by every instance of the component.
+    class CompiledExpression {
+      public:
+        enum class OpCode : uint8_t {
+            input,
+            notOp,
+            andOp,
+            orOp,
+            xorOp
+        };
+
+        struct Instruction {
+            OpCode op;
+            uint8_t operand; // index of the input for OpCode::input
+        };
+
+        // expression digits are single character input indices
+        static constexpr int maxInputs = 10;
+        static constexpr int maxStackDepth = 32;
+
+        CompiledExpression() = default;
+        CompiledExpression(const std::string &expression, int inputCount);
+
+        // bit i of `inputs` is the state of input i
+        bool evaluate(uint32_t inputs) const;
+
+        // every bit lane of the input words is an independent evaluation
+        uint64_t evaluateLanes(const uint64_t *inputs) const;
+
+        const std::vector<Instruction> &getProgram() const;
+
+        int getInputCount() const;
+
+      private:
+        void buildTruthTable();
+
+        std::vector<Instruction> m_program = {};
+        // one bit per input combination, indexed by the packed inputs
+        std::vector<uint64_t> m_truthTable = {};
+        int m_inputCount = 0;
+    };
+} // namespace Bess::Simulator
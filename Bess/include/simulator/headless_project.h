@@ -0,0 +1,74 @@
+#pragma once
+
+#include "common/digital_state.h"
+#include "simulator/netlist.h"
+#include "uuid.h"
+
+#include "json.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Bess::Simulator {
+    // Loads the simulation side of a .bproj file into its own netlist without
+    // creating any renderable component, for the tools that run without a window.
+    // Probes and clocks are indexed in the order they appear in the file.
+    class HeadlessProject {
+      public:
+        HeadlessProject() = default;
+        HeadlessProject(const std::string &path);
+
+        // the component bank has to be loaded before, throws std::runtime_error
+        void load(const std::string &path);
+
+        const std::string &getName() const;
+
+        size_t getInputCount() const;
+        const uuids::uuid &getInputId(size_t index) const;
+        // label given to the probe, its uid when it has none
+        std::string getInputLabel(size_t index) const;
+        DigitalState getInput(size_t index) const;
+        void setInput(size_t index, DigitalState state);
+        // output pin of the probe in the netlist
+        int getInputPin(size_t index) const;
+
+        size_t getOutputCount() const;
+        const uuids::uuid &getOutputId(size_t index) const;
+        std::string getOutputLabel(size_t index) const;
+        DigitalState getOutput(size_t index) const;
+        // input pin of the probe in the netlist
+        int getOutputPin(size_t index) const;
+
+        size_t getClockCount() const;
+        // declared frequency of a clock in hertz
+        double getClockFrequency(size_t index) const;
+        // output pin of the clock in the netlist
+        int getClockPin(size_t index) const;
+        // drives the clocks by hand, stopping them if they run
+        void setClocks(DigitalState state);
+        void toggleClocks();
+        // lets the clocks toggle by themselves at their declared frequency
+        void startClocks();
+
+        void step(SimTime ticks = 1);
+
+        Netlist &getNetlist();
+
+      private:
+        void loadComponent(const nlohmann::json &data);
+        // type is used for the slots saved as a bare uid
+        uuids::uuid loadSlot(const nlohmann::json &data, ComponentType type);
+        std::vector<uuids::uuid> loadSlots(const nlohmann::json &data, ComponentType type);
+
+        Netlist m_netlist;
+        std::string m_name = "";
+
+        // output pins of the input probes and clocks, input pins of the output probes
+        std::vector<int> m_inputPins = {}, m_outputPins = {}, m_clockPins = {};
+        std::vector<uuids::uuid> m_inputIds = {}, m_outputIds = {};
+        std::vector<std::string> m_inputLabels = {}, m_outputLabels = {};
+        std::vector<int> m_clockNodes = {};
+        std::vector<double> m_clockFrequencies = {};
+        DigitalState m_clockState = DigitalState::low;
+    };
+} // namespace Bess::Simulator
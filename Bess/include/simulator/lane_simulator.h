@@ -0,0 +1,38 @@
+#pragma once
+
+#include "simulator/levelizer.h"
+#include "simulator/netlist.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Bess::Simulator {
+    // Bit-parallel evaluation of a netlist: every pin holds a 64 bit word and each
+    // bit lane is an independent circuit state, so one pass over the levels
+    // evaluates 64 input vectors. Sequential nodes keep the outputs they are given,
+    // which makes it suited to sweeping the combinational logic between them.
+    class LaneSimulator {
+      public:
+        static constexpr int laneCount = 64;
+        static constexpr int maxFeedbackPasses = 64;
+
+        // lanes start from the current pin states of the netlist
+        LaneSimulator(const Netlist &netlist);
+
+        // sets the lanes of an output pin, e.g. the one of an input probe
+        void setPin(int pin, uint64_t lanes);
+        uint64_t getPin(int pin) const;
+
+        // evaluates the combinational nodes, returns false when the feedback
+        // loops did not settle within maxFeedbackPasses
+        bool evaluate();
+
+      private:
+        // returns true if one of the outputs changed
+        bool evaluateNode(int node);
+
+        const Netlist &m_netlist;
+        Levelization m_levels;
+        std::vector<uint64_t> m_pinLanes = {};
+    };
+} // namespace Bess::Simulator
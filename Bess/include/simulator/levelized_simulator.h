@@ -0,0 +1,74 @@
+#pragma once
+
+#include "simulator/levelizer.h"
+#include "simulator/netlist.h"
+#include "simulator/thread_pool.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Bess::Simulator {
+    // Zero delay evaluation of the acyclic combinational part of a netlist. The
+    // nodes of a level only read pins written by earlier levels, so a level is
+    // split over the thread pool. Feedback loops and sequential nodes are handed
+    // to the event driven path of the netlist.
+    //
+    // The netlist defers the levelized nodes to it and runs a pass after every
+    // tick whose events woke some, so the outputs of clocks and flip-flops are
+    // levelized like the edits. Only the fan-out cone of the nodes the netlist
+    // logged since the last pass is evaluated, nets outside of it keep
+    // their values. The first pass evaluates every level.
+    class LevelizedSimulator : public DeferredEvaluator {
+      public:
+        // levels smaller than this are evaluated on the calling thread
+        static constexpr size_t parallelThreshold = 1024;
+        static constexpr size_t grainSize = 256;
+
+        // 0 threads uses one per hardware thread. Hooks into the netlist and
+        // its change log, so nothing may be simulating it meanwhile.
+        LevelizedSimulator(Netlist &netlist, size_t threadCount = 0);
+        ~LevelizedSimulator() override;
+
+        // Until the circuit is levelized again after an edit every node is
+        // deferred, the next pass hands the non levelized ones back.
+        bool defers(int node) override;
+
+        // evaluates the changed cone level by level, then schedules the non
+        // levelized nodes whose inputs changed on the netlist
+        void evaluate() override;
+
+        const Levelization &getLevelization();
+
+        // levelized nodes evaluated since the simulator was made
+        size_t getEvaluatedCount() const;
+
+      private:
+        void relevelize();
+        // seeds the cone with the logged levelized nodes
+        void collectChanges();
+        void markDirty(int node);
+        void evaluateNode(int node);
+
+        Netlist &m_netlist;
+        ThreadPool m_pool;
+
+        Levelization m_levels;
+        uint64_t m_revision = UINT64_MAX;
+
+        // level of every node, -1 for the nodes that are not levelized
+        std::vector<int> m_nodeLevels = {};
+        // nodes of each level left to evaluate in this pass
+        std::vector<std::vector<int>> m_dirty = {};
+        std::vector<uint8_t> m_queued = {};
+        bool m_evaluateAll = true;
+        // nodes were deferred while the levels were out of date
+        bool m_stale = false;
+        Netlist::Changes m_changes = {};
+
+        // levelized nodes evaluated in this pass, in level order
+        std::vector<int> m_evaluated = {};
+        size_t m_evaluatedCount = 0;
+        // levelized nodes whose outputs changed in the last evaluation
+        std::vector<uint8_t> m_changed = {};
+    };
+} // namespace Bess::Simulator
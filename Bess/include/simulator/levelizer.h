@@ -0,0 +1,29 @@
+#pragma once
+
+#include "simulator/netlist.h"
+
+#include <vector>
+
+namespace Bess::Simulator {
+    // Combinational nodes of a netlist grouped by topological rank. Probes, clocks
+    // and flip-flops are the sources, so a level only depends on the levels before
+    // it. Nodes on a combinational feedback loop, or fed by one, cannot be ranked
+    // and are listed apart in `cyclic`.
+    struct Levelization {
+        std::vector<std::vector<int>> levels = {};
+        std::vector<int> cyclic = {};
+    };
+
+    class Levelizer {
+      public:
+        static Levelization levelize(const Netlist &netlist);
+
+        // Strongly connected components of the combinational nodes that form a
+        // feedback loop, nodes feeding their own inputs included. Nodes fed by
+        // a loop without being on it are left out.
+        static std::vector<std::vector<int>> findLoops(const Netlist &netlist);
+
+        // true for the nodes evaluated from their inputs alone
+        static bool isCombinational(NodeKind kind);
+    };
+} // namespace Bess::Simulator
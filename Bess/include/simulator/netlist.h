@@ -0,0 +1,410 @@
+#pragma once
+
+#include "common/digital_state.h"
+#include "components_manager/component_type.h"
+#include "simulator/timing_wheel.h"
+#include "simulator/trace_recorder.h"
+#include "uuid.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Bess::Simulator::Components {
+    class JComponentData;
+}
+
+namespace Bess::Simulator {
+    // simulation behaviour of a node, resolved once when the node is added
+    enum class NodeKind : uint8_t {
+        none,
+        inputProbe,
+        outputProbe,
+        clock,
+        jcomponent,
+        jkFlipFlop,
+        dFlipFlop,
+        // Multi-bit sequential nodes, up to 64 bits wide with the state packed
+        // in words. The width is the number of outputs Q0..Qn-1, the inputs are
+        //   dRegister     D0..Dn-1
+        //   counter       EN, DOWN, RST (synchronous)
+        //   shiftRegister SI, EN, shifts towards Qn-1
+        //   registerFile  D0..Dn-1, WA0..WAa-1, WE, RA0..RAa-1, the read is
+        //                 not clocked and shows the word at RA
+        dRegister,
+        counter,
+        shiftRegister,
+        registerFile,
+        // Bus nodes. A bus pin carries a word of up to 64 bits instead of one
+        // bit, its DigitalState is high when any bit is set.
+        //   splitter      one bus input, one output per bit, least significant first
+        //   merger        one input per bit, one bus output
+        // Both pass the bits on without delay. A jcomponent whose data works on
+        // words becomes a wordComponent, its ports take the data's widths.
+        splitter,
+        merger,
+        wordComponent,
+        // combinational region replaced by its truth table, see Netlist::collapse
+        lookupTable,
+        // jcomponent taken over by a lookupTable node, kept to be expanded back
+        collapsed
+    };
+
+    enum class ClockEdge : uint8_t {
+        rising,
+        falling
+    };
+
+    // Takes over the evaluation of some nodes to run them in an order of its
+    // own. The netlist logs the nodes it defers instead of queueing them, see
+    // Netlist::trackChanges, and runs the evaluator once the zero delay events
+    // of a tick settled.
+    class DeferredEvaluator {
+      public:
+        virtual ~DeferredEvaluator() = default;
+        virtual bool defers(int node) = 0;
+        // evaluates the nodes deferred since the last call
+        virtual void evaluate() = 0;
+    };
+
+    // Flat, index based view of the circuit used by the simulation hot path.
+    // Slots become pins and their parent components become nodes, both get dense
+    // integer ids and the pin states live in one contiguous array. Uuids are only
+    // kept to map edits coming from the ComponentsManager onto the indices.
+    //
+    // Wires have no delay. A node's outputs change `delay` ticks after the
+    // evaluation on a timing wheel, with inertial delay: a pulse shorter than the
+    // delay is swallowed because the newer evaluation cancels the pending event.
+    // Clock nodes with a frequency toggle their output on the same wheel, so the
+    // edges land on exact simulated times whatever the speed of the host.
+    class Netlist {
+      public:
+        static constexpr int invalidId = -1;
+        static constexpr SimTime defaultDelay = 1;
+        // largest region collapse() turns into a table, 2^16 entries
+        static constexpr int maxLookupInputs = 16;
+        // output changes per node a feedback loop may go through without one
+        // of its inputs from outside changing, more make it oscillating
+        static constexpr uint64_t maxLoopChanges = 64;
+        // rounds of zero delay events per tick, the rest carries over
+        static constexpr int maxDeltaCycles = 1024;
+
+        struct Pin {
+            ComponentType type = ComponentType::none;
+            int node = invalidId;
+            // fan-out pins for output pins, driving pins for input pins
+            std::vector<int> connections = {};
+            uuids::uuid uid;
+            // input only read on the clock edge of its node, it does not wake it
+            bool sampled = false;
+            // bits carried by the pin, more than one for bus pins
+            uint8_t width = 1;
+            // state changes are written to the trace recorder
+            bool traced = false;
+            bool alive = false;
+        };
+
+        // combinational feedback loop, see getLoops()
+        struct Loop {
+            std::vector<int> nodes = {};
+            // output changes since an input from outside the loop changed
+            uint64_t changes = 0;
+            bool oscillating = false;
+            bool frozen = false;
+        };
+
+        // pins and nodes the event driven path scheduled, see trackChanges
+        struct Changes {
+            std::vector<int> pins = {};
+            std::vector<int> nodes = {};
+        };
+
+        // Bit-packed simulation state at one point in time. It only fits the
+        // netlist revision it was taken from.
+        struct Snapshot {
+            struct PendingOutput {
+                int pin;
+                SimTime time;
+                uint64_t value;
+            };
+
+            // clock level, clock schedule and words of a stateful node
+            struct NodeState {
+                int node;
+                DigitalState lastClock;
+                double clockHalfPeriod;
+                SimTime clockStart;
+                uint64_t clockEdges;
+                std::vector<uint64_t> words;
+            };
+
+            SimTime time = 0;
+            uint64_t revision = 0;
+            // one bit per pin
+            std::vector<uint64_t> pinStates = {};
+            // bus pins whose word is not 0
+            std::vector<std::pair<int, uint64_t>> pinWords = {};
+            // output changes still travelling through a node delay
+            std::vector<PendingOutput> pendingOutputs = {};
+            std::vector<NodeState> nodeStates = {};
+
+            size_t getMemoryUsage() const;
+        };
+
+        // work done since the last resetStats(), for profiling
+        struct Stats {
+            // output changes delivered by the timing wheel, clock edges included
+            uint64_t events = 0;
+            uint64_t evaluations = 0;
+        };
+
+        struct Node {
+            NodeKind kind = NodeKind::none;
+            std::vector<int> inputs = {};
+            std::vector<int> outputs = {};
+            int clockPin = invalidId;
+            // edge triggered nodes only wake up on this edge of the clock pin
+            ClockEdge clockEdge = ClockEdge::rising;
+            DigitalState lastClock = DigitalState::low;
+            // packed state of the multi-bit sequential nodes
+            std::vector<uint64_t> words = {};
+            // packed outputs of a lookupTable node for every input combination
+            std::vector<uint32_t> table = {};
+            // nodes a lookupTable node replaces
+            std::vector<int> members = {};
+            // lookupTable node a collapsed node belongs to
+            int collapsedInto = invalidId;
+            SimTime delay = defaultDelay;
+            // ticks between two edges of a running clock, 0 when stopped
+            double clockHalfPeriod = 0.0;
+            SimTime clockStart = 0;
+            uint64_t clockEdges = 0;
+            int clockEvent = TimingWheel::invalidHandle;
+            // feedback loop the node is on, if any
+            int loop = invalidId;
+            const Components::JComponentData *jcompData = nullptr;
+            uuids::uuid uid;
+            bool alive = false;
+        };
+
+        Netlist() = default;
+
+        int addPin(const uuids::uuid &uid, ComponentType type);
+        void removePin(const uuids::uuid &uid);
+        int getPinId(const uuids::uuid &uid) const;
+        const std::unordered_map<uuids::uuid, int> &getPinIds() const;
+
+        int addNode(const uuids::uuid &uid, NodeKind kind,
+                    const std::vector<uuids::uuid> &inputs,
+                    const std::vector<uuids::uuid> &outputs,
+                    const uuids::uuid &clockPin = {},
+                    const Components::JComponentData *jcompData = nullptr);
+        void removeNode(const uuids::uuid &uid);
+        int getNodeId(const uuids::uuid &uid) const;
+
+        // flip flops sample their inputs on this edge, rising by default
+        void setClockEdge(int node, ClockEdge edge);
+
+        // nodes with a clock pin that sample their inputs on its edge
+        static bool isEdgeTriggered(NodeKind kind);
+
+        // address bits of a register file node, from its pin counts
+        static int getAddressBits(const Node &node);
+
+        // 0 stops the clock, its output then only changes when driven
+        void setClockFrequency(int node, double hertz);
+
+        // Evaluates a combinational region of jcomponent nodes for every input
+        // combination and replaces it by one lookupTable node, which costs one
+        // table read per change instead of an evaluation per gate. The region
+        // delay becomes its longest path. Wires read outside the region keep
+        // being driven, internal ones too while the table has room for them.
+        // Throws if the region has a loop or more than maxLookupInputs inputs.
+        int collapse(const std::vector<uuids::uuid> &nodes);
+        // puts the nodes replaced by a lookupTable node back, editing a pin or
+        // node of the region expands it as well
+        void expand(int node);
+
+        // outputs of a jcomponent or lookupTable node, bit i of `inputs` is
+        // the state of input i
+        static uint32_t evaluateCombinational(const Node &node, uint32_t inputs);
+
+        void connect(const uuids::uuid &outputPin, const uuids::uuid &inputPin);
+        void disconnect(const uuids::uuid &outputPin, const uuids::uuid &inputPin);
+
+        DigitalState getPinState(int pin) const;
+
+        // wired-or of the pins driving an input pin, in constant time
+        DigitalState resolveDrivers(int pin) const;
+
+        // word on a pin, 0 or 1 for single bit pins
+        uint64_t getPinWord(int pin) const;
+        // words of every pin, only bus pins use their entry
+        const std::vector<uint64_t> &getPinWords() const;
+
+        // bus counterpart of drivePin, the word is cut to the pin width
+        void driveWord(int pin, uint64_t word);
+
+        // Stores a state without scheduling anything, for evaluators that order
+        // the nodes themselves. Different pins can be set from different threads.
+        void setPinState(int pin, DigitalState state);
+
+        // re-resolves an input pin and schedules its node if the state changed
+        void updateInputPin(int pin);
+
+        // Copies the state of a settled netlist, nothing may be left for
+        // settle() to process.
+        Snapshot takeSnapshot() const;
+        // puts the netlist back at the time of the snapshot, throws
+        // std::runtime_error if pins, nodes or connections changed since
+        void restoreSnapshot(const Snapshot &snapshot);
+
+        // While tracked, every pin and node scheduled by a drive or an edit is
+        // also logged, so evaluators that order the nodes themselves only have
+        // to revisit the fan-out cone of what changed since their last pass.
+        void trackChanges(bool track);
+        // hands the log over to `changes` and starts a new one
+        void takeChanges(Changes &changes);
+
+        // Combinational feedback loops as of the last tick, they are found
+        // again after every edit. A loop whose outputs keep changing while its
+        // inputs from outside stay the same is marked oscillating.
+        const std::vector<Loop> &getLoops() const;
+        // Oscillating loops stop evaluating and hold their last states, so the
+        // rest of the circuit keeps running at full speed. Disabling it lets
+        // the frozen loops run again.
+        void setFreezeOscillations(bool freeze);
+        bool getFreezeOscillations() const;
+        // unfreezes the loops and clears their oscillating mark
+        void releaseLoops();
+        // changes whenever a loop starts oscillating, is released or goes away
+        uint64_t getOscillationRevision() const;
+
+        // recorder of the traced pins, nullptr stops recording. The recorder
+        // is owned by the caller.
+        void setTraceRecorder(TraceRecorder *recorder);
+        // only traced pins are recorded, the others cost nothing
+        void setPinTraced(int pin, bool traced);
+
+        // Evaluator of the nodes it defers while changes are tracked, nullptr
+        // queues every node again. With an evaluator only the deferred nodes
+        // are logged, the others would pile up between its passes. The
+        // evaluator is owned by the caller.
+        void setDeferredEvaluator(DeferredEvaluator *evaluator);
+
+        // drops the change scheduled for an output pin, if any
+        void cancelPendingOutput(int pin);
+
+        // changes whenever pins, nodes or connections are added or removed
+        uint64_t getRevision() const;
+
+        // sets the state of an output pin right away and schedules its fan-out
+        void drivePin(int pin, DigitalState state);
+
+        void scheduleNode(int node, SimEventType type = SimEventType::node);
+
+        // re-propagates the state of every input probe
+        void refresh();
+
+        // advances the simulated time by one tick
+        void simulate();
+
+        // advances the simulated time by `ticks`, jumping over idle stretches
+        void runFor(SimTime ticks);
+        void runUntil(SimTime time);
+
+        // true when nothing is scheduled, the circuit is stable
+        bool isIdle() const;
+
+        SimTime getTime() const;
+
+        const Stats &getStats() const;
+        void resetStats();
+
+        void clearQueue();
+        void clear();
+
+        const std::vector<Pin> &getPins() const;
+        // DigitalState of every pin, indexed by pin id
+        const std::vector<uint8_t> &getPinStates() const;
+        const std::vector<Node> &getNodes() const;
+
+      private:
+        int getOrAddPin(const uuids::uuid &uid);
+        int allocateNode();
+        // expands the collapsed region the pin belongs to, if any
+        void expandPin(int pin);
+        void schedulePin(int pin);
+        // schedules an output change of the node, replacing the pending one
+        void scheduleOutput(int pin, DigitalState state, SimTime delay);
+        void scheduleWord(int pin, uint64_t word, SimTime delay);
+        void scheduleClockEdge(int node);
+        void stopClock(int node);
+        // runs the zero delay events and the deferred evaluator in turn
+        // until the pins are resolved
+        void settle();
+        // at most maxDeltaCycles rounds of zero delay events
+        void settleQueue();
+
+        void evaluateNode(int node, bool refresh);
+        // records the clock level, true if it just made the node's edge
+        bool takeClockEdge(Node &node);
+        void evaluateFlipFlop(int node);
+        void evaluateRegister(int node);
+        void evaluateBus(int node);
+        void propagate(int pin);
+        void tracePin(int pin);
+        // finds the feedback loops again if the netlist changed
+        void updateLoops();
+        void countLoopChange(int loop);
+        void freezeLoop(int loop);
+
+        std::vector<Pin> m_pins = {};
+        std::vector<uint8_t> m_pinStates = {};
+        // Drivers of every input pin that are high, kept up to date as output
+        // pins change so resolving a net never walks its drivers. Only input
+        // pins use their entry.
+        std::vector<uint32_t> m_highDrivers = {};
+        // words of the bus pins, wired buses resolve to the or of their drivers
+        std::vector<uint64_t> m_pinWords = {};
+        // word a pending output event of a bus pin will drive
+        std::vector<uint64_t> m_pendingWords = {};
+        std::vector<Node> m_nodes = {};
+
+        // step in which a pin or node was last processed
+        std::vector<uint32_t> m_pinStamps = {};
+        std::vector<uint32_t> m_nodeStamps = {};
+        uint32_t m_step = 0;
+        uint64_t m_revision = 0;
+        Stats m_stats = {};
+
+        std::vector<int> m_freePins = {};
+        std::vector<int> m_freeNodes = {};
+
+        std::unordered_map<uuids::uuid, int> m_pinIds = {};
+        std::unordered_map<uuids::uuid, int> m_nodeIds = {};
+
+        // zero delay events, processed in rounds
+        std::vector<SimEvent> m_currentQueue = {}, m_nextQueue = {};
+
+        TimingWheel m_wheel;
+        std::vector<SimEvent> m_dueEvents = {};
+        // wheel handle of the pending change of every output pin
+        std::vector<int> m_pendingEvents = {};
+
+        TraceRecorder *m_trace = nullptr;
+
+        DeferredEvaluator *m_deferred = nullptr;
+        bool m_deferredPending = false;
+
+        bool m_trackChanges = false;
+        Changes m_changes = {};
+
+        std::vector<Loop> m_loops = {};
+        // input pins of loop nodes driven from outside their loop
+        std::vector<uint8_t> m_loopInputs = {};
+        uint64_t m_loopRevision = UINT64_MAX;
+        uint64_t m_oscillationRevision = 0;
+        bool m_freezeOscillations = false;
+    };
+} // namespace Bess::Simulator
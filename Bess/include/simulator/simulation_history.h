@@ -0,0 +1,66 @@
+#pragma once
+
+#include "simulator/netlist.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+
+namespace Bess::Simulator {
+    // Snapshots of a running netlist taken at a fixed interval of simulated
+    // time, together with the inputs driven in between. Rewinding restores the
+    // newest snapshot before the target and simulates forward to it again.
+    // Once the snapshots exceed the memory budget the oldest ones are dropped.
+    // Editing the circuit invalidates the whole history.
+    //
+    // capture(), recordInput() and rewind() have to be called from the thread
+    // owning the netlist, the time bounds can be read from any thread.
+    class SimulationHistory {
+      public:
+        static constexpr SimTime defaultInterval = 10'000'000;
+        static constexpr size_t defaultMemoryBudget = size_t(64) << 20;
+
+        SimulationHistory(SimTime interval = defaultInterval, size_t memoryBudget = defaultMemoryBudget);
+
+        // takes a snapshot if an interval has passed since the last one
+        void capture(const Netlist &netlist);
+
+        // a pin driven from outside the netlist, replayed by rewind()
+        void recordInput(SimTime time, int pin, DigitalState state);
+
+        // Puts the netlist at `time` and forgets everything after it. Returns
+        // false if no snapshot is old enough, the netlist is left untouched.
+        bool rewind(Netlist &netlist, SimTime time);
+
+        void clear();
+
+        void setInterval(SimTime interval);
+        SimTime getInterval() const;
+
+        // range rewind() can reach, both 0 while the history is empty
+        SimTime getOldestTime() const;
+        SimTime getLatestTime() const;
+
+        size_t getMemoryUsage() const;
+        size_t getSnapshotCount() const;
+
+      private:
+        struct Input {
+            SimTime time;
+            int pin;
+            DigitalState state;
+        };
+
+        void updateBounds();
+
+        SimTime m_interval;
+        size_t m_memoryBudget;
+
+        std::deque<Netlist::Snapshot> m_snapshots = {};
+        std::deque<Input> m_inputs = {};
+        size_t m_memoryUsage = 0;
+
+        std::atomic<SimTime> m_oldestTime = 0;
+        std::atomic<SimTime> m_latestTime = 0;
+    };
+} // namespace Bess::Simulator
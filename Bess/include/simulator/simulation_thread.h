@@ -0,0 +1,137 @@
+#pragma once
+
+#include "simulator/levelized_simulator.h"
+#include "simulator/netlist.h"
+#include "simulator/simulation_history.h"
+#include "simulator/snapshot_buffer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Bess::Simulator {
+    // Runs a netlist on its own thread at a configurable tick rate, independent
+    // of the frame rate. By default the simulated time follows the wall clock,
+    // turbo (a rate of 0) runs it as fast as the host allows. The pin states are
+    // published through a SnapshotBuffer.
+    // Changes from other threads are either queued with push(), which never
+    // waits, or applied with edit(), which waits for the current batch of ticks
+    // to end and can return a result. Both are applied in order.
+    class SimulationThread {
+      public:
+        typedef std::function<void(Netlist &)> Command;
+
+        // feedback loop reported by the netlist as oscillating
+        struct LoopReport {
+            std::vector<uuids::uuid> nodes;
+            bool frozen;
+        };
+
+        // longest time the thread holds the netlist for one batch of ticks
+        static constexpr double maxBatchSeconds = 0.002;
+        // bounds of the ticks run between two checks of the clock
+        static constexpr uint64_t minSlice = 64;
+        static constexpr uint64_t maxSlice = uint64_t(1) << 32;
+
+        SimulationThread(Netlist &netlist);
+        ~SimulationThread();
+
+        SimulationThread(const SimulationThread &) = delete;
+        SimulationThread &operator=(const SimulationThread &) = delete;
+
+        void start();
+        void stop();
+
+        // returns the sequence number of the command, see getPinId()
+        uint64_t push(Command command);
+
+        // runs ticks right away on the calling thread
+        void step(uint64_t ticks = 1);
+
+        template <typename Fn>
+        auto edit(Fn &&fn) {
+            std::lock_guard lock(m_netlistMutex);
+            applyCommands();
+            m_dirty = true;
+            return fn(m_netlist);
+        }
+
+        void setPaused(bool paused);
+        bool isPaused() const;
+
+        // ticks per wall clock second, ticksPerSecond is real time and 0 runs
+        // as many ticks as possible
+        void setTickRate(double rate);
+        double getTickRate() const;
+
+        // ticks run over the last second
+        double getAchievedTickRate() const;
+
+        // Evaluates the combinational logic level by level on `threadCount`
+        // threads, or goes back to the event driven path only. The simulator
+        // turns the change log of the netlist on and off, so it is made and
+        // dropped under the netlist lock.
+        void setLevelized(bool enabled, size_t threadCount = 0);
+
+        // history captured after every batch of ticks, nullptr stops capturing
+        void setHistory(SimulationHistory *history);
+
+        // reader side of the snapshot, from a single thread
+        bool acquireSnapshot();
+        const std::vector<uint8_t> &getSnapshot() const;
+        // simulated time of the last published snapshot, from any thread
+        SimTime getTime() const;
+        // Id of a pin as of the last publish, from any thread. Returns
+        // Netlist::invalidId until the commands up to `command`, as numbered
+        // by push(), were applied and published.
+        int getPinId(const uuids::uuid &uid, uint64_t command) const;
+
+        // oscillating loops as of the last publish, from any thread
+        std::vector<LoopReport> getOscillatingLoops() const;
+        // changes whenever the oscillating loops do
+        uint64_t getOscillationRevision() const;
+
+      private:
+        void run();
+        void applyCommands();
+        void runTicks(uint64_t ticks);
+        void publish();
+
+        Netlist &m_netlist;
+        std::unique_ptr<LevelizedSimulator> m_levelized = nullptr;
+        SimulationHistory *m_history = nullptr;
+        std::mutex m_netlistMutex;
+
+        std::vector<Command> m_commands = {}, m_pendingCommands = {};
+        std::mutex m_commandsMutex;
+        uint64_t m_pushedCommands = 0;
+        uint64_t m_appliedCommands = 0;
+        std::condition_variable m_wake;
+
+        SnapshotBuffer m_snapshot;
+        // set when the netlist changed since the last publish
+        bool m_dirty = true;
+
+        std::thread m_thread;
+        std::atomic<bool> m_running = false;
+        std::atomic<bool> m_paused = false;
+        std::atomic<double> m_tickRate = double(ticksPerSecond);
+        std::atomic<double> m_achievedTickRate = 0.0;
+        std::atomic<SimTime> m_time = 0;
+
+        // pin ids as of the last publish, copied when the netlist changed
+        std::unordered_map<uuids::uuid, int> m_pinIds = {};
+        uint64_t m_pinIdsRevision = UINT64_MAX;
+        uint64_t m_publishedCommands = 0;
+        mutable std::mutex m_pinIdsMutex;
+
+        std::vector<LoopReport> m_oscillatingLoops = {};
+        mutable std::mutex m_oscillationMutex;
+        std::atomic<uint64_t> m_oscillationRevision = 0;
+    };
+} // namespace Bess::Simulator
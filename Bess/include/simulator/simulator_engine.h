@@ -1,30 +1,117 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
-#include <queue>
-#include "uuid.h"
-#include "common/digital_state.h"
+#include "simulator/levelized_simulator.h"
+#include "simulator/netlist.h"
+#include "simulator/simulation_history.h"
+#include "simulator/simulation_thread.h"
+#include "simulator/trace_recorder.h"
 
 namespace Bess::Simulator {
+    enum class SimulationMode {
+        eventDriven,
+        // zero delay levelized pass over the combinational logic on every step,
+        // the event driven path only handles feedback loops and sequential nodes
+        levelized
+    };
+
     class Engine {
     public:
-        struct SimQueueElement{
-            uuids::uuid uid;
-            uuids::uuid changerId;
-            DigitalState state;
-        };
-
-        static int evaluateExpression(const std::string& expression, const std::vector<int>& arr);
         static void RefreshSimulation();
+        // runs one tick right away, on the calling thread
         static void Simulate();
-        static void addToSimQueue(const uuids::uuid& uid, const uuids::uuid& changerId, Simulator::DigitalState state);
         static void clearQueue();
-    private:
-        static int applyBinaryOperator(int a, int b, char op);
-        static int applyUnaryOperator(int a, char op);
 
-        static std::queue<SimQueueElement> currentSimQueue, nextSimQueue;
+        static void start();
+        static void stop();
+
+        // Netlist of the open project, kept in sync by the ComponentsManager.
+        // While the simulation thread runs it only may be changed through
+        // push() or edit().
+        static Netlist& getNetlist();
+
+        // returns the sequence number of the command, see getPinId()
+        static uint64_t push(SimulationThread::Command command);
+
+        // drives an input pin from the UI, recorded for replay by rewindTo()
+        static void drivePin(int pin, DigitalState state);
+        // same for a pin whose id is not known yet
+        static void drivePin(const uuids::uuid &pin, DigitalState state);
+
+        // id of a pin as of the last published snapshot, Netlist::invalidId
+        // until the command `command` that added it was applied
+        static int getPinId(const uuids::uuid &pin, uint64_t command);
 
+        template <typename Fn>
+        static auto edit(Fn&& fn) {
+            return m_thread.edit(std::forward<Fn>(fn));
+        }
+
+        // picks up the latest pin states published by the simulation thread,
+        // called once per frame so the whole frame renders the same snapshot
+        static void update();
+        static DigitalState getPinState(int pin);
+
+        static void setPaused(bool paused);
+        // ticks per second, ticksPerSecond runs in real time and 0 is turbo,
+        // as fast as possible
+        static void setTickRate(double rate);
+        static double getTickRate();
+        static double getAchievedTickRate();
+
+        // 0 threads uses one per hardware thread
+        static void setMode(SimulationMode mode, size_t threadCount = 0);
+        static SimulationMode getMode();
+
+        // Records the state changes of the traced signals. The ring buffer is
+        // allocated when tracing starts and dropped when it stops.
+        static void setTracing(bool enabled);
+        static bool isTracing();
+        static void traceSignal(const TraceSignal& signal);
+        static void clearTracedSignals();
+        static const std::vector<TraceSignal>& getTracedSignals();
+        // writes the recorded changes of the traced signals as a VCD file,
+        // throws std::runtime_error if the file cannot be written
+        static void exportTrace(const std::string& path);
+
+        // Keeps snapshots of the simulation every `interval` ticks so it can be
+        // rewound. Editing the circuit starts a new history.
+        static void setHistoryEnabled(bool enabled);
+        static bool isHistoryEnabled();
+        static void setHistoryInterval(SimTime interval);
+        static SimTime getHistoryInterval();
+        // puts the simulation back at `time`, false if the history does not
+        // reach that far. The trace is cleared, it would mix both timelines.
+        static bool rewindTo(SimTime time);
+        // rewinds by one history interval
+        static bool stepBack();
+        // oldest time rewindTo() can reach, 0 while the history is empty
+        static SimTime getHistoryStart();
+        // simulated time of the last published step
+        static SimTime getTime();
+
+        // components on a combinational feedback loop that keeps changing
+        // without its inputs changing, as of the last update()
+        static bool isOscillating(const uuids::uuid& node);
+        static size_t getOscillatingLoopCount();
+        // frozen loops hold their states so the rest of the circuit runs on
+        static void setFreezeOscillations(bool freeze);
+        static bool getFreezeOscillations();
+        // lets the frozen loops run again and clears the reports
+        static void releaseLoops();
+    private:
+        static Netlist m_netlist;
+        static SimulationThread m_thread;
+        static SimulationMode m_mode;
+        static std::unique_ptr<TraceRecorder> m_trace;
+        static std::vector<TraceSignal> m_tracedSignals;
+        static std::unique_ptr<SimulationHistory> m_history;
+        static std::unordered_set<uuids::uuid> m_oscillatingNodes;
+        static size_t m_oscillatingLoopCount;
+        static uint64_t m_oscillationRevision;
+        static bool m_freezeOscillations;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace Bess::Simulator {
+    // Lock-free hand over of the pin states from the simulation thread to the
+    // renderer. The writer fills its back buffer and publishes it, the reader
+    // picks up the latest published one. A third buffer sits between them so
+    // neither side ever waits on, or writes to, the buffer the other one holds.
+    class SnapshotBuffer {
+      public:
+        // writer side
+        std::vector<uint8_t> &getBackBuffer();
+        void publish();
+
+        // reader side, switches to the latest published buffer if there is a
+        // newer one and returns true if it did
+        bool acquire();
+        const std::vector<uint8_t> &getFrontBuffer() const;
+
+      private:
+        static constexpr int indexMask = 3;
+        static constexpr int freshBit = 4;
+
+        std::array<std::vector<uint8_t>, 3> m_buffers = {};
+        int m_back = 0;
+        int m_front = 1;
+        // index of the buffer in between, with freshBit set once published
+        std::atomic<int> m_middle = 2;
+    };
+} // namespace Bess::Simulator
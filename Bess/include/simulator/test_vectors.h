@@ -0,0 +1,96 @@
+#pragma once
+
+#include "simulator/netlist.h"
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+
+namespace Bess::Simulator {
+    // One step of a test: the inputs to drive and the outputs expected once the
+    // netlist settled. Values are keyed by probe label, the runner tells inputs
+    // from outputs by the probe they name.
+    struct TestStep {
+        // -1 for an output that is not checked
+        std::vector<std::pair<std::string, int>> values = {};
+        // line of a CSV file or index in a JSON file, for the report
+        size_t line = 0;
+    };
+
+    // The steps of a test run in order from the initial state of the netlist,
+    // tests are independent of each other.
+    //
+    // CSV files start with a row of probe labels, every next row is a test of
+    // one step. Values are 0, 1 or x for an output that is not checked, an
+    // empty cell leaves an input unchanged. JSON files hold either
+    //   {"vectors": [{"a": 1, "b": 0, "sum": 1}, ...]}
+    // with one test per vector, or
+    //   {"sequences": [[{"clk": 1}, {"clk": 0, "q": 1}], ...]}
+    // with one test per sequence.
+    struct TestVectorFile {
+        std::vector<std::vector<TestStep>> tests = {};
+
+        // picks the format from the extension, throws std::runtime_error
+        static TestVectorFile load(const std::string &path);
+        static TestVectorFile fromCsv(std::istream &stream);
+        static TestVectorFile fromJson(const nlohmann::json &json);
+    };
+
+    // Applies test vectors to copies of a netlist, the tests are sharded over
+    // a thread pool and every thread works on its own copy.
+    class TestRunner {
+      public:
+        // upper bound on the ticks a step waits for the netlist to go idle,
+        // running clocks keep it busy for all of them
+        static constexpr SimTime defaultSettleTicks = 1'000'000;
+
+        struct Probe {
+            std::string label;
+            int pin;
+        };
+
+        struct Mismatch {
+            size_t test;
+            size_t step;
+            size_t line;
+            std::string label;
+            DigitalState expected;
+            DigitalState actual;
+        };
+
+        struct Report {
+            size_t tests = 0;
+            size_t steps = 0;
+            size_t failedTests = 0;
+            // ordered by test and step
+            std::vector<Mismatch> mismatches = {};
+        };
+
+        // inputs are the output pins of the input probes, outputs the input
+        // pins of the output probes. The netlist is copied.
+        TestRunner(const Netlist &netlist, std::vector<Probe> inputs, std::vector<Probe> outputs);
+
+        void setSettleTicks(SimTime ticks);
+
+        // throws std::runtime_error if a label names no probe or an input is
+        // given x. 0 threads uses one per hardware thread.
+        Report run(const TestVectorFile &vectors, size_t threadCount = 0) const;
+
+      private:
+        struct ResolvedStep {
+            std::vector<std::pair<int, DigitalState>> inputs;
+            // probe index and expected state
+            std::vector<std::pair<int, DigitalState>> expected;
+            size_t line;
+        };
+
+        std::vector<std::vector<ResolvedStep>> resolve(const TestVectorFile &vectors) const;
+        void settle(Netlist &netlist) const;
+
+        Netlist m_netlist;
+        std::vector<Probe> m_inputs, m_outputs;
+        SimTime m_settleTicks = defaultSettleTicks;
+    };
+} // namespace Bess::Simulator
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Bess::Simulator {
+    // Fixed set of worker threads with one task deque each. Workers take their
+    // own tasks from the front and steal from the back of the others' deques
+    // when they run out. The calling thread works too while it waits.
+    class ThreadPool {
+      public:
+        // 0 uses one thread per hardware thread
+        ThreadPool(size_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        // threads running tasks, the calling thread included
+        size_t getThreadCount() const;
+
+        // calls fn(begin, end) over [0, count) in chunks of at most `grain`
+        // and returns once every chunk ran
+        void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)> &fn);
+
+      private:
+        struct Task {
+            size_t begin;
+            size_t end;
+            const std::function<void(size_t, size_t)> *fn;
+            std::atomic<size_t> *remaining;
+        };
+
+        struct TaskQueue {
+            std::deque<Task> tasks;
+            std::mutex mutex;
+        };
+
+        void workerLoop(size_t index);
+        bool takeTask(size_t index, Task &task);
+        void runTask(const Task &task);
+
+        // the last queue belongs to the calling thread
+        std::vector<std::unique_ptr<TaskQueue>> m_queues = {};
+        std::vector<std::thread> m_threads = {};
+
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wake;
+        std::atomic<size_t> m_queuedTasks = 0;
+        bool m_stop = false;
+    };
+} // namespace Bess::Simulator
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "common/digital_state.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Bess::Simulator {
+    // simulated time, one tick is a nanosecond
+    typedef uint64_t SimTime;
+    constexpr SimTime ticksPerSecond = 1'000'000'000;
+
+    enum class SimEventType : uint8_t {
+        pin,
+        node,
+        // re-propagates the outputs of a node even if their state did not change
+        refresh
+    };
+
+    struct SimEvent {
+        int target; // pin or node index, based on type
+        SimEventType type;
+        DigitalState state;
+    };
+
+    // Hierarchical timing wheel holding the events scheduled in the future.
+    // Level 0 has one slot per tick, every next level covers a whole turn of the
+    // previous one per slot and is cascaded down as the time reaches it.
+    // Events live in a pool and are linked through their slot, so scheduling
+    // does not allocate once the pool has grown to the circuit's activity.
+    class TimingWheel {
+      public:
+        static constexpr int invalidHandle = -1;
+
+        TimingWheel();
+
+        // `time` has to be after the current time, returns a handle for cancel()
+        int schedule(SimTime time, const SimEvent &event);
+
+        // the event is dropped when its slot is reached
+        void cancel(int handle);
+
+        // time and event of a scheduled event that was not delivered yet
+        SimTime getEventTime(int handle) const;
+        const SimEvent &getEvent(int handle) const;
+
+        // moves to the next tick and appends the events due at it to `due`
+        void advance(std::vector<SimEvent> &due);
+
+        // last time up to which nothing can become due, UINT64_MAX when empty
+        SimTime getIdleUntil() const;
+        // jumps over idle time, `time` must not be after getIdleUntil()
+        void skipTo(SimTime time);
+
+        SimTime getTime() const;
+
+        // number of scheduled events that were not cancelled
+        size_t size() const;
+
+        // drops every event but keeps the current time, events scheduled
+        // afterwards are still relative to it
+        void clear();
+        // drops every event and moves to `time`, backwards too
+        void reset(SimTime time);
+
+      private:
+        static constexpr int levelBits = 8;
+        static constexpr int slotCount = 1 << levelBits;
+        static constexpr int levelCount = 4;
+
+        struct PooledEvent {
+            SimTime time;
+            SimEvent event;
+            int next;
+            bool cancelled;
+        };
+
+        void insert(int handle);
+        // re-inserts the events of the slot of `level` that the current time reached
+        void cascade(int level);
+        void release(int handle);
+
+        std::vector<PooledEvent> m_pool = {};
+        std::vector<int> m_freeEvents = {};
+
+        // head of the event list of every slot
+        std::array<std::array<int, slotCount>, levelCount> m_slots;
+        // events further away than the last level can hold
+        std::vector<int> m_overflow = {};
+        // events stored in the slots of each level, cancelled ones included
+        std::array<size_t, levelCount> m_levelCounts = {};
+
+        SimTime m_time = 0;
+        size_t m_size = 0;
+    };
+} // namespace Bess::Simulator
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "simulator/timing_wheel.h"
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Bess::Simulator {
+    // net picked for the trace, named for the waveform viewer
+    struct TraceSignal {
+        int pin;
+        std::string name;
+        int width = 1;
+    };
+
+    // Ring buffer of the state changes of the traced pins. Recording is a
+    // constant time store into memory allocated up front, once the buffer is
+    // full the oldest changes are overwritten. The levelized pass records from
+    // several threads, so the write position is claimed atomically.
+    class TraceRecorder {
+      public:
+        static constexpr size_t defaultCapacity = size_t(1) << 18;
+
+        struct Record {
+            SimTime time;
+            uint64_t value;
+            int pin;
+        };
+
+        // the capacity is rounded up to a power of two
+        explicit TraceRecorder(size_t capacity = defaultCapacity);
+
+        void record(SimTime time, int pin, uint64_t value) {
+            const uint64_t index = std::atomic_ref(m_head).fetch_add(1, std::memory_order_relaxed);
+            m_records[index & m_mask] = {time, value, pin};
+        }
+
+        void clear();
+
+        // changes still in the buffer, oldest first
+        std::vector<Record> getRecords() const;
+        size_t getCapacity() const;
+        // changes recorded since the last clear(), overwritten ones included
+        uint64_t getRecordedCount() const;
+
+        // Value Change Dump of the signals, one tick per nanosecond. Signals
+        // read x until their first change still in the buffer.
+        void writeVcd(std::ostream &stream, const std::vector<TraceSignal> &signals) const;
+
+      private:
+        std::vector<Record> m_records = {};
+        uint64_t m_mask = 0;
+        uint64_t m_head = 0;
+    };
+} // namespace Bess::Simulator
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Bess::Simulator {
+    // Postfix form of a word level JComponent output expression, the bus
+    // counterpart of CompiledExpression. Digits are inputs as in bit
+    // expressions, `#` starts a literal (#12, #0xff) and the operators follow
+    // C: ~ * + - << >> < > == & ^ |. Comparisons give 1 or 0, the result is
+    // cut to the width of the output by the caller.
+    class WordExpression {
+      public:
+        enum class OpCode : uint8_t {
+            input,
+            literal,
+            notOp,
+            mulOp,
+            addOp,
+            subOp,
+            shlOp,
+            shrOp,
+            lessOp,
+            greaterOp,
+            equalOp,
+            andOp,
+            xorOp,
+            orOp
+        };
+
+        struct Instruction {
+            OpCode op;
+            // input index or literal value
+            uint64_t operand;
+        };
+
+        static constexpr int maxInputs = 10;
+        static constexpr int maxStackDepth = 32;
+
+        WordExpression() = default;
+        WordExpression(const std::string &expression, int inputCount);
+
+        uint64_t evaluate(const uint64_t *inputs) const;
+
+        const std::vector<Instruction> &getProgram() const;
+
+      private:
+        std::vector<Instruction> m_program = {};
+    };
+} // namespace Bess::Simulator
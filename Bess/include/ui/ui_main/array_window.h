@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+
+namespace Bess::UI {
+    // places a grid of the last placed component, optionally chained together
+    class ArrayWindow {
+      public:
+        static void hide();
+        static void show();
+        static void draw();
+
+        static bool isShown();
+
+      private:
+        static void place();
+
+        static bool m_shown;
+        static int m_rows;
+        static int m_cols;
+        static float m_spacing[2];
+        static std::string m_links;
+        static std::string m_error;
+    };
+} // namespace Bess::UI
@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+
+namespace Bess::UI {
+    // saves the current selection as a subcircuit component
+    class SubcircuitWindow {
+      public:
+        static void hide();
+        static void show();
+        static void draw();
+
+        static bool isShown();
+
+      private:
+        static bool m_shown;
+        static std::string m_name;
+        static std::string m_collection;
+        static std::string m_error;
+    };
+} // namespace Bess::UI
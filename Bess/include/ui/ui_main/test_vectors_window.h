@@ -0,0 +1,26 @@
+#pragma once
+#include "simulator/test_vectors.h"
+
+#include <string>
+
+namespace Bess::UI {
+    // runs a file of test vectors against the probes of the open project
+    class TestVectorsWindow {
+      public:
+        static void hide();
+        static void show();
+        static void draw();
+
+        static bool isShown();
+
+      private:
+        static void run();
+
+        static bool m_shown;
+        static std::string m_path;
+        static int m_settleTicks;
+        static std::string m_error;
+        static bool m_hasReport;
+        static Simulator::TestRunner::Report m_report;
+    };
+} // namespace Bess::UI
@@ -12,8 +12,10 @@
 #include "components/flip_flops/flip_flops.h"
 #include "components_manager/component_bank.h"
 #include "components_manager/components_manager.h"
+#include "simulator/simulator_engine.h"
 
 #include "components/clock.h"
+#include "components/splitter.h"
 #include "settings/settings.h"
 
 #include "common/bind_helpers.h"
@@ -138,6 +140,7 @@ namespace Bess {
         Config::Settings::init();
 
         Simulator::ComponentsManager::init();
+        Simulator::Engine::start();
 
         Simulator::ComponentBankElement el(Simulator::ComponentType::inputProbe, "Input Probe");
         Simulator::ComponentBank::addToCollection("I/O", el);
@@ -148,6 +151,15 @@ namespace Bess {
 
         Simulator::ComponentBank::addToCollection("Flip Flops", {Simulator::ComponentType::flipFlop, JKFlipFlop::name});
         Simulator::ComponentBank::addToCollection("Flip Flops", {Simulator::ComponentType::flipFlop, DFlipFlop::name});
+        Simulator::ComponentBank::addToCollection("Flip Flops", {Simulator::ComponentType::flipFlop, DRegister::name});
+        Simulator::ComponentBank::addToCollection("Flip Flops", {Simulator::ComponentType::flipFlop, Counter::name});
+        Simulator::ComponentBank::addToCollection("Flip Flops", {Simulator::ComponentType::flipFlop, ShiftRegister::name});
+        Simulator::ComponentBank::addToCollection("Flip Flops", {Simulator::ComponentType::flipFlop, RegisterFile::name});
+
+        for (auto width : Splitter::bankWidths) {
+            Simulator::ComponentBank::addToCollection("Buses", {Simulator::ComponentType::splitter, Splitter::getBankName(Simulator::ComponentType::splitter, width)});
+            Simulator::ComponentBank::addToCollection("Buses", {Simulator::ComponentType::merger, Splitter::getBankName(Simulator::ComponentType::merger, width)});
+        }
 
         UI::init(m_mainWindow->getGLFWHandle());
 
@@ -163,7 +175,10 @@ namespace Bess {
         m_mainWindow->onMouseMove(BIND_FN_2(Application::onMouseMove));
     }
 
-    void Application::shutdown() { m_mainWindow->close(); }
+    void Application::shutdown() {
+        Simulator::Engine::stop();
+        m_mainWindow->close();
+    }
 
     void Application::loadProject(const std::string &path) {
         Pages::MainPageState::getInstance()->loadProject(path);
@@ -0,0 +1,473 @@
+#include "components_manager/component_bank.h"
+#include "simulator/levelized_simulator.h"
+#include "simulator/netlist.h"
+
+#include "json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Bess::Simulator;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr auto gatesCollection = "Digital Gates";
+
+    void printUsage() {
+        std::cout << "Usage: bess_bench [options]\n"
+                  << "  --bank <path>          component collections file (default assets/comp_collections.json)\n"
+                  << "  --out <path>           write the json report to a file instead of stdout\n"
+                  << "  --max-gates <n>        skip the circuits larger than n gates (default 1000000)\n"
+                  << "  --vectors <n>          input changes settled per combinational circuit (default 16)\n"
+                  << "  --threads <n>          threads of the levelized runs, 0 uses all of them (default 0)\n"
+                  << "  --seed <n>             seed of the random circuits and vectors (default 1)\n";
+    }
+
+    size_t getPeakMemory() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return usage.ru_maxrss;
+#else
+        return usage.ru_maxrss * 1024;
+#endif
+#endif
+    }
+
+    double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Builds circuits straight into a netlist, the same calls the
+    // ComponentsManager makes for the components of a project.
+    class CircuitBuilder {
+      public:
+        struct Gate {
+            std::vector<uuids::uuid> inputs, outputs;
+        };
+
+        CircuitBuilder(uint32_t seed) : m_rng(seed), m_uuids(m_rng) {
+        }
+
+        Netlist &getNetlist() {
+            return *m_netlist;
+        }
+
+        size_t getGateCount() const {
+            return m_gates;
+        }
+
+        uuids::uuid addPin(ComponentType type) {
+            auto uid = m_uuids();
+            m_netlist->addPin(uid, type);
+            return uid;
+        }
+
+        // output pin of a new input probe
+        uuids::uuid addInput() {
+            auto slot = addPin(ComponentType::outputSlot);
+            m_netlist->addNode(m_uuids(), NodeKind::inputProbe, {}, {slot});
+            return slot;
+        }
+
+        void addOutput(const uuids::uuid &driver) {
+            auto slot = addPin(ComponentType::inputSlot);
+            m_netlist->addNode(m_uuids(), NodeKind::outputProbe, {slot}, {});
+            m_netlist->connect(driver, slot);
+        }
+
+        uuids::uuid addClock(double hertz) {
+            auto slot = addPin(ComponentType::outputSlot);
+            int node = m_netlist->addNode(m_uuids(), NodeKind::clock, {}, {slot});
+            m_netlist->setClockFrequency(node, hertz);
+            return slot;
+        }
+
+        // a gate from the gates collection, its first inputs connected to `drivers`
+        Gate addGate(const std::string &name, const std::vector<uuids::uuid> &drivers) {
+            auto data = ComponentBank::getJCompData(gatesCollection, name);
+            if (data == nullptr)
+                throw std::runtime_error(name + " is not in the component bank");
+
+            Gate gate;
+            for (int i = 0; i < data->getInputCount(); i++)
+                gate.inputs.emplace_back(addPin(ComponentType::inputSlot));
+            for (size_t i = 0; i < data->getOutputs().size(); i++)
+                gate.outputs.emplace_back(addPin(ComponentType::outputSlot));
+
+            m_netlist->addNode(m_uuids(), NodeKind::jcomponent, gate.inputs, gate.outputs, {}, data.get());
+            for (size_t i = 0; i < drivers.size() && i < gate.inputs.size(); i++)
+                m_netlist->connect(drivers[i], gate.inputs[i]);
+            m_gates++;
+            return gate;
+        }
+
+        // first output pin of a new gate
+        uuids::uuid addGate1(const std::string &name, const std::vector<uuids::uuid> &drivers) {
+            return addGate(name, drivers).outputs[0];
+        }
+
+        // q and q' of a new JK flip flop
+        std::vector<uuids::uuid> addJKFlipFlop(const uuids::uuid &clock, const uuids::uuid &j, const uuids::uuid &k) {
+            std::vector<uuids::uuid> inputs = {addPin(ComponentType::inputSlot), addPin(ComponentType::inputSlot)};
+            std::vector<uuids::uuid> outputs = {addPin(ComponentType::outputSlot), addPin(ComponentType::outputSlot)};
+            auto clockSlot = addPin(ComponentType::inputSlot);
+
+            m_netlist->addNode(m_uuids(), NodeKind::jkFlipFlop, inputs, outputs, clockSlot);
+            m_netlist->connect(j, inputs[0]);
+            m_netlist->connect(k, inputs[1]);
+            m_netlist->connect(clock, clockSlot);
+            m_gates++;
+            return outputs;
+        }
+
+        std::mt19937 &getRng() {
+            return m_rng;
+        }
+
+        int getPinId(const uuids::uuid &uid) const {
+            return m_netlist->getPinId(uid);
+        }
+
+      private:
+        std::unique_ptr<Netlist> m_netlist = std::make_unique<Netlist>();
+        std::mt19937 m_rng;
+        uuids::uuid_random_generator m_uuids;
+        size_t m_gates = 0;
+    };
+
+    struct Options {
+        size_t maxGates = 1000000;
+        int vectors = 16;
+        size_t threads = 0;
+        uint32_t seed = 1;
+    };
+
+    // runs until nothing is scheduled, returns false if it did not within `maxTicks`
+    bool settle(Netlist &netlist, SimTime maxTicks = SimTime(1) << 32) {
+        const SimTime end = netlist.getTime() + maxTicks;
+        while (!netlist.isIdle()) {
+            if (netlist.getTime() >= end)
+                return false;
+            netlist.runFor(64);
+        }
+        return true;
+    }
+
+    void addThroughput(nlohmann::json &result, const Netlist &netlist, double seconds) {
+        const auto &stats = netlist.getStats();
+        result["events"] = stats.events;
+        result["evaluations"] = stats.evaluations;
+        result["eventsPerSecond"] = seconds > 0.0 ? stats.events / seconds : 0.0;
+        result["evaluationsPerSecond"] = seconds > 0.0 ? stats.evaluations / seconds : 0.0;
+    }
+
+    // Applies random input vectors and settles after each one, with the event
+    // driven path and with the levelized one.
+    void runVectors(nlohmann::json &result, CircuitBuilder &builder, const std::vector<uuids::uuid> &inputs,
+                    const Options &options, const std::function<bool()> &check = {}) {
+        auto &netlist = builder.getNetlist();
+        auto &rng = builder.getRng();
+
+        auto applyVector = [&]() {
+            for (auto &input : inputs)
+                netlist.drivePin(builder.getPinId(input), rng() & 1 ? DigitalState::high : DigitalState::low);
+        };
+
+        auto start = Clock::now();
+        bool settled = settle(netlist);
+        result["initialSettleSeconds"] = secondsSince(start);
+
+        netlist.resetStats();
+        const SimTime startTime = netlist.getTime();
+        bool valid = true;
+        double settleSeconds = 0.0;
+        for (int i = 0; i < options.vectors; i++) {
+            applyVector();
+            start = Clock::now();
+            settled &= settle(netlist);
+            settleSeconds += secondsSince(start);
+            if (check)
+                valid &= check();
+        }
+
+        result["vectors"] = options.vectors;
+        result["settled"] = settled;
+        if (check)
+            result["valid"] = valid;
+        result["settleSeconds"] = settleSeconds / std::max(options.vectors, 1);
+        result["simulatedTicks"] = netlist.getTime() - startTime;
+        addThroughput(result, netlist, settleSeconds);
+
+        LevelizedSimulator levelized(netlist, options.threads);
+        start = Clock::now();
+        levelized.getLevelization();
+        result["levelizeSeconds"] = secondsSince(start);
+
+        // the first pass evaluates every level, the vectors only their cone
+        settle(netlist);
+
+        double levelizedSeconds = 0.0;
+        const size_t evaluatedBefore = levelized.getEvaluatedCount();
+        bool levelizedValid = true;
+        for (int i = 0; i < options.vectors; i++) {
+            applyVector();
+            start = Clock::now();
+            settle(netlist);
+            levelizedSeconds += secondsSince(start);
+            if (check)
+                levelizedValid &= check();
+        }
+        result["levelizedSettleSeconds"] = levelizedSeconds / std::max(options.vectors, 1);
+        result["levelizedEvaluations"] = (levelized.getEvaluatedCount() - evaluatedBefore) / std::max(options.vectors, 1);
+        if (check)
+            result["levelizedValid"] = levelizedValid;
+    }
+
+    nlohmann::json benchRippleAdder(int bits, const Options &options) {
+        nlohmann::json result = {{"circuit", "ripple_carry_adder"}, {"size", bits}};
+        auto start = Clock::now();
+
+        CircuitBuilder builder(options.seed);
+        std::vector<uuids::uuid> a, b, sum;
+        auto carry = builder.addInput();
+        std::vector<uuids::uuid> inputs = {carry};
+        for (int i = 0; i < bits; i++) {
+            a.emplace_back(builder.addInput());
+            b.emplace_back(builder.addInput());
+            inputs.emplace_back(a.back());
+            inputs.emplace_back(b.back());
+
+            auto half = builder.addGate1("XOR Gate", {a[i], b[i]});
+            sum.emplace_back(builder.addGate1("XOR Gate", {half, carry}));
+            auto generate = builder.addGate1("AND Gate", {a[i], b[i]});
+            auto propagate = builder.addGate1("AND Gate", {half, carry});
+            carry = builder.addGate1("OR Gate", {generate, propagate});
+            builder.addOutput(sum.back());
+        }
+        builder.addOutput(carry);
+        result["gates"] = builder.getGateCount();
+        result["buildSeconds"] = secondsSince(start);
+
+        // the sum is checked against the host's addition while it fits a word
+        std::function<bool()> check;
+        if (bits <= 62) {
+            check = [&, bits]() {
+                auto &netlist = builder.getNetlist();
+                auto value = [&](const std::vector<uuids::uuid> &pins) {
+                    uint64_t word = 0;
+                    for (int i = 0; i < bits; i++) {
+                        if (netlist.getPinState(builder.getPinId(pins[i])) == DigitalState::high)
+                            word |= 1ull << i;
+                    }
+                    return word;
+                };
+                uint64_t expected = value(a) + value(b) + (netlist.getPinState(builder.getPinId(inputs[0])) == DigitalState::high);
+                uint64_t actual = value(sum) | uint64_t(netlist.getPinState(builder.getPinId(carry)) == DigitalState::high) << bits;
+                return expected == actual;
+            };
+        }
+
+        runVectors(result, builder, inputs, options, check);
+        return result;
+    }
+
+    nlohmann::json benchRandomDag(size_t gates, const Options &options) {
+        static const std::vector<std::string> gateNames = {"AND Gate", "OR Gate", "NAND Gate", "NOR Gate", "XOR Gate", "XNOR Gate"};
+
+        nlohmann::json result = {{"circuit", "random_dag"}, {"size", gates}};
+        auto start = Clock::now();
+
+        CircuitBuilder builder(options.seed);
+        auto &rng = builder.getRng();
+        const size_t inputCount = std::max<size_t>(16, static_cast<size_t>(std::sqrt(double(gates))));
+        // drivers are picked among the latest signals, which sets the depth
+        const size_t window = inputCount * 4;
+
+        std::vector<uuids::uuid> inputs, signals;
+        for (size_t i = 0; i < inputCount; i++) {
+            inputs.emplace_back(builder.addInput());
+            signals.emplace_back(inputs.back());
+        }
+
+        for (size_t i = 0; i < gates; i++) {
+            const size_t from = signals.size() > window ? signals.size() - window : 0;
+            std::uniform_int_distribution<size_t> pick(from, signals.size() - 1);
+            const auto &name = gateNames[rng() % gateNames.size()];
+            signals.emplace_back(builder.addGate1(name, {signals[pick(rng)], signals[pick(rng)]}));
+        }
+        for (size_t i = signals.size() - std::min<size_t>(64, gates); i < signals.size(); i++)
+            builder.addOutput(signals[i]);
+
+        result["gates"] = builder.getGateCount();
+        result["inputs"] = inputCount;
+        result["buildSeconds"] = secondsSince(start);
+
+        runVectors(result, builder, inputs, options);
+        return result;
+    }
+
+    nlohmann::json benchCounterChain(int stages, const Options &options) {
+        constexpr double clockHertz = 100e6;
+        constexpr SimTime runTicks = ticksPerSecond / 1000;
+
+        nlohmann::json result = {{"circuit", "counter_chain"}, {"size", stages}};
+        auto start = Clock::now();
+
+        // ripple counter, every stage toggles on the falling edge of the previous one
+        CircuitBuilder builder(options.seed);
+        auto high = builder.addInput();
+        builder.getNetlist().drivePin(builder.getPinId(high), DigitalState::high);
+        auto clock = builder.addClock(clockHertz);
+        for (int i = 0; i < stages; i++) {
+            auto outputs = builder.addJKFlipFlop(clock, high, high);
+            builder.addOutput(outputs[0]);
+            clock = outputs[1];
+        }
+        result["gates"] = builder.getGateCount();
+        result["clockHertz"] = clockHertz;
+        result["buildSeconds"] = secondsSince(start);
+
+        auto &netlist = builder.getNetlist();
+        netlist.resetStats();
+        start = Clock::now();
+        netlist.runFor(runTicks);
+        const double seconds = secondsSince(start);
+
+        result["simulatedTicks"] = runTicks;
+        result["runSeconds"] = seconds;
+        result["cyclesPerSecond"] = clockHertz * (double(runTicks) / ticksPerSecond) / seconds;
+        addThroughput(result, netlist, seconds);
+        return result;
+    }
+
+    nlohmann::json benchInverterRing(int length, const Options &options) {
+        constexpr SimTime runTicks = 1000000;
+
+        nlohmann::json result = {{"circuit", "inverter_ring"}, {"size", length}};
+        auto start = Clock::now();
+
+        // a NAND closes the ring so it settles while disabled, enabling it
+        // then sends a single edge around
+        CircuitBuilder builder(options.seed);
+        auto enable = builder.addInput();
+        auto &netlist = builder.getNetlist();
+
+        auto nand = builder.addGate("NAND Gate", {enable});
+        auto signal = nand.outputs[0];
+        // an even number of inverters, the NAND makes the loop odd
+        const int inverters = length - 1 - (length - 1) % 2;
+        for (int i = 0; i < inverters; i++)
+            signal = builder.addGate1("NOT Gate", {signal});
+        netlist.connect(signal, nand.inputs[1]);
+
+        result["gates"] = builder.getGateCount();
+        result["buildSeconds"] = secondsSince(start);
+
+        settle(netlist);
+        netlist.drivePin(builder.getPinId(enable), DigitalState::high);
+        netlist.resetStats();
+        start = Clock::now();
+        netlist.runFor(runTicks);
+        const double seconds = secondsSince(start);
+
+        result["simulatedTicks"] = runTicks;
+        result["runSeconds"] = seconds;
+        addThroughput(result, netlist, seconds);
+        return result;
+    }
+} // namespace
+
+int main(int argc, char **argv) {
+    std::string bankPath = "assets/comp_collections.json";
+    std::string outPath = "";
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--bank" && hasValue) {
+            bankPath = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else if (arg == "--max-gates" && hasValue) {
+            options.maxGates = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--vectors" && hasValue) {
+            options.vectors = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        } else {
+            std::cerr << "[-] Unknown argument " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    nlohmann::json report;
+    report["tickSeconds"] = 1.0 / ticksPerSecond;
+    report["seed"] = options.seed;
+    report["results"] = nlohmann::json::array();
+
+    try {
+        ComponentBank::loadMultiFromJson(bankPath);
+
+        // each entry is the circuit's gate count, to honour --max-gates
+        auto run = [&](size_t gates, auto &&bench) {
+            if (gates > options.maxGates)
+                return;
+            auto result = bench();
+            result["peakMemoryBytes"] = getPeakMemory();
+            std::cerr << "[+] " << result["circuit"].dump() << " " << result["size"] << std::endl;
+            report["results"].emplace_back(std::move(result));
+        };
+
+        for (int bits : {16, 62, 1024, 16384})
+            run(bits * 5, [&] { return benchRippleAdder(bits, options); });
+        for (int stages : {8, 64, 1024})
+            run(stages, [&] { return benchCounterChain(stages, options); });
+        for (int length : {101, 10001, 1000001})
+            run(length, [&] { return benchInverterRing(length, options); });
+        for (size_t gates : {1000, 10000, 100000, 1000000})
+            run(gates, [&] { return benchRandomDag(gates, options); });
+    } catch (const std::exception &e) {
+        std::cerr << "[-] " << e.what() << std::endl;
+        return 1;
+    }
+
+    report["peakMemoryBytes"] = getPeakMemory();
+
+    if (outPath.empty()) {
+        std::cout << report.dump(2) << std::endl;
+    } else {
+        std::ofstream file(outPath);
+        file << report.dump(2) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,275 @@
+#include "components_manager/component_bank.h"
+#include "simulator/headless_project.h"
+#include "simulator/lane_simulator.h"
+#include "simulator/levelized_simulator.h"
+#include "simulator/test_vectors.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace Bess::Simulator;
+
+namespace {
+    void printUsage() {
+        std::cout << "Usage: bess-cli <project.bproj> [options]\n"
+                  << "  --bank <path>          component collections file (default assets/comp_collections.json)\n"
+                  << "  --inputs <bits>        states of the input probes in file order, e.g. 0110\n"
+                  << "  --steps <n>            steps to run (default 64)\n"
+                  << "  --step-ticks <n>       ticks of simulated time per step, a tick is 1ns (default 1)\n"
+                  << "  --seconds <s>          simulated time to run, cut into --steps steps unless --step-ticks is given\n"
+                  << "  --clock-period <n>     steps between clock edges, 0 keeps the clocks low (default 0)\n"
+                  << "  --run-clocks           toggle the clocks at their declared frequency instead\n"
+                  << "  --trace                print the output probes after every step\n"
+                  << "  --vcd <path>           record the probes and clocks and write them as a VCD file\n"
+                  << "  --exhaustive           print the truth table over every input combination\n"
+                  << "  --test <path>          check the output probes against a CSV or JSON file of test vectors\n"
+                  << "  --settle-ticks <n>     ticks a test vector may take to settle (default 1000000)\n"
+                  << "  --collapse             replace the combinational components by one lookup table\n"
+                  << "  --levelized            evaluate the combinational logic level by level after every tick\n"
+                  << "  --freeze-loops         hold oscillating feedback loops at their last states\n"
+                  << "  --threads <n>          threads of the levelized mode, 0 uses all of them (default 0)\n";
+    }
+
+    // the input combinations are evaluated 64 at a time, one per bit lane
+    void printTruthTable(HeadlessProject &project) {
+        constexpr size_t maxInputs = 24;
+        const size_t inputCount = project.getInputCount();
+        if (inputCount > maxInputs)
+            throw std::runtime_error("Exhaustive runs support at most " + std::to_string(maxInputs) + " input probes");
+
+        // settles the initial state the sequential nodes hold
+        project.getNetlist().runFor(64);
+        LaneSimulator lanes(project.getNetlist());
+
+        const uint64_t combinations = 1ull << inputCount;
+        for (uint64_t base = 0; base < combinations; base += LaneSimulator::laneCount) {
+            for (size_t i = 0; i < inputCount; i++) {
+                uint64_t word = 0;
+                for (int lane = 0; lane < LaneSimulator::laneCount; lane++) {
+                    if (((base + lane) >> i) & 1)
+                        word |= 1ull << lane;
+                }
+                lanes.setPin(project.getInputPin(i), word);
+            }
+
+            if (!lanes.evaluate())
+                std::cerr << "[-] Feedback loops did not settle for inputs from " << base << std::endl;
+
+            for (int lane = 0; lane < LaneSimulator::laneCount && base + lane < combinations; lane++) {
+                std::string row;
+                for (size_t i = 0; i < inputCount; i++)
+                    row += ((base + lane) >> i) & 1 ? '1' : '0';
+                row += ' ';
+                for (size_t i = 0; i < project.getOutputCount(); i++)
+                    row += (lanes.getPin(project.getOutputPin(i)) >> lane) & 1 ? '1' : '0';
+                std::cout << row << '\n';
+            }
+        }
+    }
+
+    // returns false if a vector did not match
+    bool runTestVectors(HeadlessProject &project, const std::string &path, SimTime settleTicks, int threads) {
+        std::vector<TestRunner::Probe> inputs, outputs;
+        for (size_t i = 0; i < project.getInputCount(); i++)
+            inputs.push_back({project.getInputLabel(i), project.getInputPin(i)});
+        for (size_t i = 0; i < project.getOutputCount(); i++)
+            outputs.push_back({project.getOutputLabel(i), project.getOutputPin(i)});
+
+        TestRunner runner(project.getNetlist(), std::move(inputs), std::move(outputs));
+        runner.setSettleTicks(settleTicks);
+        auto report = runner.run(TestVectorFile::load(path), threads);
+
+        for (auto &mismatch : report.mismatches) {
+            std::cout << "vector " << mismatch.line << " step " << mismatch.step << ": " << mismatch.label
+                      << " expected " << (mismatch.expected == DigitalState::high ? 1 : 0)
+                      << " got " << (mismatch.actual == DigitalState::high ? 1 : 0) << '\n';
+        }
+        std::cout << report.tests - report.failedTests << "/" << report.tests << " tests passed, "
+                  << report.steps << " steps, " << report.mismatches.size() << " mismatches" << std::endl;
+        return report.failedTests == 0;
+    }
+
+    std::string outputBits(const HeadlessProject &project) {
+        std::string bits;
+        for (size_t i = 0; i < project.getOutputCount(); i++) {
+            bits += project.getOutput(i) == DigitalState::high ? '1' : '0';
+        }
+        return bits;
+    }
+} // namespace
+
+int main(int argc, char **argv) {
+    std::string projectPath = "";
+    std::string bankPath = "assets/comp_collections.json";
+    std::string inputs = "";
+    std::string vcdPath = "";
+    std::string testPath = "";
+    SimTime settleTicks = TestRunner::defaultSettleTicks;
+    uint64_t steps = 64;
+    uint64_t stepTicks = 0;
+    double seconds = 0.0;
+    int clockPeriod = 0;
+    bool runClocks = false;
+    bool trace = false;
+    bool exhaustive = false;
+    bool levelized = false;
+    bool collapse = false;
+    bool freezeLoops = false;
+    int threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--bank" && hasValue) {
+            bankPath = argv[++i];
+        } else if (arg == "--inputs" && hasValue) {
+            inputs = argv[++i];
+        } else if (arg == "--steps" && hasValue) {
+            steps = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--step-ticks" && hasValue) {
+            stepTicks = std::max<uint64_t>(std::strtoull(argv[++i], nullptr, 10), 1);
+        } else if (arg == "--seconds" && hasValue) {
+            seconds = std::atof(argv[++i]);
+        } else if (arg == "--clock-period" && hasValue) {
+            clockPeriod = std::atoi(argv[++i]);
+        } else if (arg == "--run-clocks") {
+            runClocks = true;
+        } else if (arg == "--trace") {
+            trace = true;
+        } else if (arg == "--vcd" && hasValue) {
+            vcdPath = argv[++i];
+        } else if (arg == "--test" && hasValue) {
+            testPath = argv[++i];
+        } else if (arg == "--settle-ticks" && hasValue) {
+            settleTicks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--exhaustive") {
+            exhaustive = true;
+        } else if (arg == "--collapse") {
+            collapse = true;
+        } else if (arg == "--freeze-loops") {
+            freezeLoops = true;
+        } else if (arg == "--levelized") {
+            levelized = true;
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        } else if (projectPath.empty() && !arg.starts_with("--")) {
+            projectPath = arg;
+        } else {
+            std::cerr << "[-] Unknown argument " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (projectPath.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        ComponentBank::loadMultiFromJson(bankPath);
+        HeadlessProject project(projectPath);
+
+        if (collapse) {
+            std::vector<uuids::uuid> region;
+            for (auto &node : project.getNetlist().getNodes()) {
+                if (node.alive && node.kind == NodeKind::jcomponent)
+                    region.emplace_back(node.uid);
+            }
+            int table = project.getNetlist().collapse(region);
+            std::cerr << "[+] Collapsed " << region.size() << " components into a table of "
+                      << project.getNetlist().getNodes()[table].inputs.size() << " inputs" << std::endl;
+        }
+
+        if (exhaustive) {
+            printTruthTable(project);
+            return 0;
+        }
+
+        if (!testPath.empty())
+            return runTestVectors(project, testPath, settleTicks, threads) ? 0 : 2;
+
+        TraceRecorder recorder(vcdPath.empty() ? 1 : TraceRecorder::defaultCapacity);
+        std::vector<TraceSignal> signals;
+        if (!vcdPath.empty()) {
+            for (size_t i = 0; i < project.getInputCount(); i++)
+                signals.push_back({project.getInputPin(i), "in" + std::to_string(i)});
+            for (size_t i = 0; i < project.getOutputCount(); i++)
+                signals.push_back({project.getOutputPin(i), "out" + std::to_string(i)});
+            for (size_t i = 0; i < project.getClockCount(); i++)
+                signals.push_back({project.getClockPin(i), "clk" + std::to_string(i)});
+
+            project.getNetlist().setTraceRecorder(&recorder);
+            for (auto &signal : signals)
+                project.getNetlist().setPinTraced(signal.pin, true);
+        }
+
+        if (inputs.size() > project.getInputCount())
+            throw std::runtime_error("Project has only " + std::to_string(project.getInputCount()) + " input probes");
+
+        for (size_t i = 0; i < inputs.size(); i++) {
+            project.setInput(i, inputs[i] == '1' ? DigitalState::high : DigitalState::low);
+        }
+
+        std::unique_ptr<LevelizedSimulator> levels = nullptr;
+        if (levelized)
+            levels = std::make_unique<LevelizedSimulator>(project.getNetlist(), threads);
+
+        project.getNetlist().setFreezeOscillations(freezeLoops);
+        if (runClocks)
+            project.startClocks();
+        if (seconds > 0.0) {
+            auto ticks = static_cast<SimTime>(seconds * ticksPerSecond);
+            if (!trace && clockPeriod == 0 && stepTicks == 0) {
+                // nothing to do between the steps, the netlist skips the idle ticks itself
+                project.step(ticks);
+                steps = 0;
+            } else {
+                // the span is cut into --steps steps unless their length was given
+                if (stepTicks == 0)
+                    stepTicks = std::max<uint64_t>(ticks / std::max<uint64_t>(steps, 1), 1);
+                steps = ticks / stepTicks;
+            }
+        }
+        stepTicks = std::max<uint64_t>(stepTicks, 1);
+
+        for (uint64_t i = 0; i < steps; i++) {
+            if (clockPeriod > 0 && i > 0 && i % clockPeriod == 0)
+                project.toggleClocks();
+
+            project.step(stepTicks);
+
+            if (trace)
+                std::cout << i << " " << outputBits(project) << std::endl;
+        }
+
+        for (auto &loop : project.getNetlist().getLoops()) {
+            if (loop.oscillating)
+                std::cerr << "[-] Feedback loop of " << loop.nodes.size() << " components oscillates"
+                          << (loop.frozen ? ", it was frozen" : "") << std::endl;
+        }
+
+        for (size_t i = 0; i < project.getOutputCount(); i++) {
+            std::cout << "out" << i << " " << uuids::to_string(project.getOutputId(i)) << " "
+                      << (project.getOutput(i) == DigitalState::high ? 1 : 0) << std::endl;
+        }
+
+        if (!vcdPath.empty()) {
+            std::ofstream file(vcdPath);
+            if (!file)
+                throw std::runtime_error("Cannot write the trace to " + vcdPath);
+            recorder.writeVcd(file, signals);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "[-] " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -53,18 +53,12 @@ namespace Bess::Common {
         auto seed_data = std::array<int, std::mt19937::state_size>{};
         std::generate(std::begin(seed_data), std::end(seed_data), std::ref(rd));
         std::seed_seq seq(std::begin(seed_data), std::end(seed_data));
-        std::mt19937 generator(seq);
-        m_gen = uuids::uuid_random_generator{generator};
+        m_engine.seed(seq);
+        m_gen = uuids::uuid_random_generator{m_engine};
     }
 
     uuids::uuid Helpers::UUIDGenerator::getUUID() {
-        std::random_device rd;
-        auto seed_data = std::array<int, std::mt19937::state_size>{};
-        std::generate(std::begin(seed_data), std::end(seed_data), std::ref(rd));
-        std::seed_seq seq(std::begin(seed_data), std::end(seed_data));
-        std::mt19937 generator(seq);
-        uuids::uuid_random_generator gen{generator};
-        return gen();
+        return m_gen();
     }
 
     float Helpers::calculateTextWidth(const std::string &text, float fontSize) {
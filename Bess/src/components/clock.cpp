@@ -7,8 +7,8 @@
 #include "pages/main_page/main_page_state.h"
 #include "scene/renderer/renderer.h"
 #include "settings/viewport_theme.h"
+#include "simulator/simulator_engine.h"
 #include "ui/m_widgets.h"
-#include <GLFW/glfw3.h>
 
 namespace Bess::Simulator::Components {
     Clock::Clock(const uuids::uuid &uid, int renderId, glm::vec3 position, const uuids::uuid &slotUid) : Component(uid, renderId, position, ComponentType::clock) {
@@ -17,48 +17,42 @@ namespace Bess::Simulator::Components {
         m_events[ComponentEventType::leftClick] = (OnLeftClickCB)BIND_FN_1(Clock::onLeftClick);
         m_name = "Clock";
 
-        m_transform.setScale({65.f, 25.f});
+        transform().setScale({65.f, 25.f});
+        Simulator::Engine::push([uid = m_uid, slot = m_outputSlotId](Netlist &netlist) { netlist.addNode(uid, NodeKind::clock, {}, {slot}); });
+        updateNetlistFrequency();
     }
 
-    void Clock::update() {
-        Component::update();
-
-        auto simPaused = Pages::MainPageState::getInstance()->isSimulationPaused();
-        if (simPaused)
-            return;
-
-        float frequency = m_frequency;
+    double Clock::getFrequencyInHertz() const {
         switch (m_frequencyUnit) {
         case Bess::Simulator::FrequencyUnit::kiloHertz:
-            frequency *= 1e3;
-            break;
+            return m_frequency * 1e3;
         case Bess::Simulator::FrequencyUnit::megaHertz:
-            frequency *= 1e6;
-            break;
+            return m_frequency * 1e6;
         default:
-            break;
+            return m_frequency;
         }
+    }
 
-        float cycleTime = 1.f / frequency;
-        double currTime = glfwGetTime();
-        double delta = currTime - m_prevUpdateTime;
-        if (delta > cycleTime) {
-            m_prevUpdateTime = currTime;
-
-            auto &comp = ComponentsManager::components[m_outputSlotId];
-            auto slot = std::dynamic_pointer_cast<Components::Slot>(comp);
-            slot->flipState();
-        }
+    void Clock::updateNetlistFrequency() {
+        Simulator::Engine::push([uid = m_uid, hertz = getFrequencyInHertz()](Netlist &netlist) {
+            if (int node = netlist.getNodeId(uid); node != Netlist::invalidId)
+                netlist.setClockFrequency(node, hertz);
+        });
     }
 
     void Clock::drawProperties() {
-        ImGui::DragFloat("Frequency", &m_frequency, 0.1f, 0.1f, 3.f);
+        if (ImGui::DragFloat("Frequency", &m_frequency, 0.1f, 0.1f, 3.f))
+            updateNetlistFrequency();
         std::vector<std::string> frequencies = {"Hz", "kHz", "MHz"};
         std::string currFreq = frequencies[(int)m_frequencyUnit];
         if (UI::MWidgets::ComboBox("Unit", currFreq, frequencies)) {
             auto idx = std::distance(frequencies.begin(), std::find(frequencies.begin(), frequencies.end(), currFreq));
-            m_frequencyUnit = static_cast<FrequencyUnit>(idx);
+            setFrequencyUnit(static_cast<FrequencyUnit>(idx));
         }
+
+        // simulated seconds per wall clock second scale the declared frequency
+        double speed = Simulator::Engine::getAchievedTickRate() / ticksPerSecond;
+        ImGui::Text("Achieved: %.4g cycles/s", getFrequencyInHertz() * speed);
     }
 
     void Clock::fromJson(const nlohmann::json &data) {
@@ -70,6 +64,9 @@ namespace Bess::Simulator::Components {
         pos.z = ComponentsManager::getNextZPos();
 
         float frequency = data["frequency"];
+        auto unit = FrequencyUnit::hertz;
+        if (data.contains("frequencyUnit"))
+            unit = static_cast<FrequencyUnit>(data["frequencyUnit"].get<int>());
 
         auto renderId = ComponentsManager::getNextRenderId();
 
@@ -79,6 +76,7 @@ namespace Bess::Simulator::Components {
         ComponentsManager::renderComponents.emplace_back(uid);
 
         auto clockCmp = std::dynamic_pointer_cast<Clock>(ComponentsManager::components[uid]);
+        clockCmp->setFrequencyUnit(unit);
         clockCmp->setFrequency(frequency);
     }
 
@@ -86,21 +84,32 @@ namespace Bess::Simulator::Components {
         nlohmann::json data;
         data["uid"] = Common::Helpers::uuidToStr(m_uid);
         data["type"] = (int)m_type;
-        data["pos"] = Common::Helpers::EncodeVec3(m_transform.getPosition());
+        data["pos"] = Common::Helpers::EncodeVec3(transform().getPosition());
         auto slot = (Slot *)ComponentsManager::components[m_outputSlotId].get();
         data["slot"] = slot->toJson();
         data["frequency"] = m_frequency;
+        data["frequencyUnit"] = (int)m_frequencyUnit;
         return data;
     }
 
     void Clock::setFrequency(float frequency) {
         m_frequency = frequency;
+        updateNetlistFrequency();
     }
 
     float Clock::getFrequency() {
         return m_frequency;
     }
 
+    void Clock::setFrequencyUnit(FrequencyUnit unit) {
+        m_frequencyUnit = unit;
+        updateNetlistFrequency();
+    }
+
+    FrequencyUnit Clock::getFrequencyUnit() {
+        return m_frequencyUnit;
+    }
+
     void Clock::render() {
         float thickness = 1.f;
 
@@ -113,12 +122,12 @@ namespace Bess::Simulator::Components {
 
         std::string label = "Clock";
 
-        if (m_isSelected) {
+        if (isSelected()) {
             borderColor = ViewportTheme::selectedCompColor;
         }
 
-        auto size = m_transform.getScale();
-        auto pos = m_transform.getPosition();
+        auto size = transform().getScale();
+        auto pos = transform().getPosition();
 
         Renderer2D::Renderer::quad(pos, size, bgColor, m_renderId, glm::vec4(r), borderColor, thickness);
 
@@ -1,23 +1,32 @@
 #include "components/component.h"
-#include "pages/main_page/main_page_state.h"
+#include "scene/spatial_index.h"
 
 namespace Bess::Simulator::Components {
 
+    Component::Component() {
+        m_handle = ComponentStore::add(this, m_type);
+    }
+
     Component::Component(const uuids::uuid &uid, int renderId, glm::vec3 position,
                          ComponentType type)
         : m_uid(uid), m_renderId(renderId), m_type(type) {
+        m_handle = ComponentStore::add(this, m_type);
+        transform().setPosition(position);
+    }
 
-        m_transform.setPosition(position);
+    Component::~Component() {
+        ComponentStore::remove(m_handle);
     }
 
     int Component::getRenderId() const { return m_renderId; }
 
     uuids::uuid Component::getId() const { return m_uid; }
 
-    const glm::vec3 &Component::getPosition() { return m_transform.getPosition(); }
+    const glm::vec3 &Component::getPosition() { return transform().getPosition(); }
 
     void Component::setPosition(const glm::vec3 &pos) {
-        m_transform.setPosition(pos);
+        transform().setPosition(pos);
+        Scene::SpatialIndex::invalidate(m_renderId);
     }
 
     std::string Component::getIdStr() const {
@@ -26,6 +35,18 @@ namespace Bess::Simulator::Components {
 
     ComponentType Component::getType() const { return m_type; }
 
+    ComponentHandle Component::getHandle() const { return m_handle; }
+
+    bool Component::isSelected() const {
+        assert(ComponentStore::isValid(m_handle));
+        return m_archetype->flags[m_storeIndex] & ComponentStore::selectedFlag;
+    }
+
+    bool Component::isHovered() const {
+        assert(ComponentStore::isValid(m_handle));
+        return m_archetype->flags[m_storeIndex] & ComponentStore::hoveredFlag;
+    }
+
     void Component::simulate() {}
 
     void Component::onEvent(ComponentEventData e) {
@@ -46,11 +67,15 @@ namespace Bess::Simulator::Components {
 
     void Component::drawProperties() {}
 
-    void Component::update() {
-        auto mainPageState = Pages::MainPageState::getInstance();
-        m_isSelected = mainPageState->isBulkIdPresent(m_uid);
-        m_isHovered = mainPageState->getHoveredId() == m_renderId;
+    std::vector<uuids::uuid> Component::getSlots(ComponentType) const {
+        return {};
+    }
 
+    std::string Component::getSlotLabel(ComponentType, int) const {
+        return "";
+    }
+
+    void Component::update() {
         while (!m_eventsQueue.empty()) {
             auto e = m_eventsQueue.front();
             m_eventsQueue.pop();
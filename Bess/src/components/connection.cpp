@@ -3,11 +3,13 @@
 #include "common/helpers.h"
 #include "components/connection_point.h"
 #include "components/slot.h"
+#include "components_manager/command_journal.h"
 #include "components_manager/components_manager.h"
 #include "ext/vector_float3.hpp"
 #include "ext/vector_float4.hpp"
 #include "pages/main_page/main_page_state.h"
 #include "scene/renderer/renderer.h"
+#include "simulator/simulator_engine.h"
 #include "ui/m_widgets.h"
 #include "ui/ui.h"
 #include <imgui.h>
@@ -36,7 +38,7 @@ namespace Bess::Simulator::Components {
     void Connection::renderCurveConnection(glm::vec3 startPos, glm::vec3 endPos, float weight, glm::vec4 color) {
         auto slot = ComponentsManager::getComponent<Slot>(m_slot1);
         auto posA = startPos;
-        auto pos = m_transform.getPosition();
+        auto pos = transform().getPosition();
         for (auto &pointId : m_points) {
             auto point = std::dynamic_pointer_cast<ConnectionPoint>(ComponentsManager::components[pointId]);
             point->render();
@@ -44,8 +46,8 @@ namespace Bess::Simulator::Components {
             Renderer2D::Renderer::curve(
                 {posA.x, posA.y, pos.z},
                 {posB.x, posB.y, pos.z},
-                m_isHovered ? 2.5f : 2.0f,
-                m_isSelected ? ViewportTheme::selectedWireColor : (slot->getState() == DigitalState::high) ? ViewportTheme::stateHighColor
+                isHovered() ? 2.5f : 2.0f,
+                isSelected() ? ViewportTheme::selectedWireColor : (slot->getState() == DigitalState::high) ? ViewportTheme::stateHighColor
                                                                                                            : m_color,
                 m_renderId);
             posA = posB;
@@ -54,8 +56,8 @@ namespace Bess::Simulator::Components {
         Renderer2D::Renderer::curve(
             {posA.x, posA.y, pos.z},
             {posB.x, posB.y, pos.z},
-            m_isHovered ? 2.5f : 2.0f,
-            m_isSelected ? ViewportTheme::selectedWireColor : (slot->getState() == DigitalState::high) ? ViewportTheme::stateHighColor
+            isHovered() ? 2.5f : 2.0f,
+            isSelected() ? ViewportTheme::selectedWireColor : (slot->getState() == DigitalState::high) ? ViewportTheme::stateHighColor
                                                                                                        : m_color,
             m_renderId);
     }
@@ -99,8 +101,11 @@ namespace Bess::Simulator::Components {
         auto startPos = slotB->getPosition();
         auto endPos = slotA->getPosition();
 
-        float weight = m_isHovered ? 2.5f : 2.0f;
-        glm::vec4 color = m_isSelected ? ViewportTheme::selectedWireColor : (slot->getState() == DigitalState::high) ? ViewportTheme::stateHighColor
+        float weight = isHovered() ? 2.5f : 2.0f;
+        // buses are drawn thicker than single bit wires
+        if (slot->getWidth() > 1)
+            weight *= 2.f;
+        glm::vec4 color = isSelected() ? ViewportTheme::selectedWireColor : (slot->getState() == DigitalState::high) ? ViewportTheme::stateHighColor
                                                                                                                      : m_color;
 
         if (m_type == ConnectionType::curve) {
@@ -115,21 +120,17 @@ namespace Bess::Simulator::Components {
         for (auto &cpId : m_points) {
             auto cp = std::dynamic_pointer_cast<ConnectionPoint>(ComponentsManager::components[cpId]);
             cp->update();
-            if(m_isSelected) cp->setSelected(true);
+            cp->setSelected(isSelected());
         }
     }
 
     void Connection::deleteComponent() {
-        auto slotA = (Slot *)ComponentsManager::components[m_slot1].get();
-        slotA->removeConnection(m_slot2);
-        auto slotB = (Slot *)ComponentsManager::components[m_slot2].get();
-        slotB->removeConnection(m_slot1);
-
-        if (slotA->getType() == ComponentType::inputSlot) {
-            ComponentsManager::removeSlotsToConn(m_slot1, m_slot2);
-        } else {
-            ComponentsManager::removeSlotsToConn(m_slot2, m_slot1);
-        }
+        // the points delete themselves from m_points
+        for (const auto point : std::vector(m_points))
+            ComponentsManager::deleteComponent(point);
+        // slot1 is always the input slot
+        ComponentsManager::removeSlotsToConn(m_slot1, m_slot2);
+        Simulator::Engine::push([output = m_slot2, input = m_slot1](Netlist &netlist) { netlist.disconnect(output, input); });
     }
 
     void Connection::generate(const glm::vec3 &pos) {}
@@ -166,19 +167,29 @@ namespace Bess::Simulator::Components {
         m_points.emplace_back(point);
     }
 
+    void Connection::insertPoint(const uuids::uuid &point, size_t index) {
+        m_points.insert(m_points.begin() + std::min(index, m_points.size()), point);
+    }
+
     void Connection::removePoint(const uuids::uuid &point) {
         m_points.erase(std::remove(m_points.begin(), m_points.end(), point), m_points.end());
     }
 
     uuids::uuid Connection::generate(const uuids::uuid &slot1, const uuids::uuid &slot2, const glm::vec3 &pos) {
         auto uid = Common::Helpers::uuidGenerator.getUUID();
+        restore(uid, slot1, slot2);
+        return uid;
+    }
+
+    void Connection::restore(const uuids::uuid &uid, const uuids::uuid &slot1, const uuids::uuid &slot2) {
         auto renderId = ComponentsManager::getNextRenderId();
         ComponentsManager::components[uid] = std::make_shared<Components::Connection>(uid, renderId, slot1, slot2);
         ComponentsManager::addRenderIdToCId(renderId, uid);
         ComponentsManager::addCompIdToRId(renderId, uid);
         ComponentsManager::renderComponents.emplace_back(uid);
         ComponentsManager::addSlotsToConn(slot1, slot2, uid);
-        return uid;
+        // slot1 is always the input slot and slot2 the driving output slot
+        Simulator::Engine::push([output = slot2, input = slot1](Netlist &netlist) { netlist.connect(output, input); });
     }
 
     void Connection::onLeftClick(const glm::vec2 &pos) {
@@ -217,11 +228,12 @@ namespace Bess::Simulator::Components {
         auto uid = Common::Helpers::uuidGenerator.getUUID();
         auto renderId = ComponentsManager::getNextRenderId();
         auto parentId = m_uid;
-        auto z = m_transform.getPosition().z;
+        auto z = transform().getPosition().z;
         auto position = glm::vec3(pos.x, pos.y, z+ComponentsManager::zIncrement);
         ComponentsManager::components[uid] = std::make_shared<ConnectionPoint>(uid, parentId, renderId, position);
         ComponentsManager::addRenderIdToCId(renderId, uid);
         ComponentsManager::addCompIdToRId(renderId, uid);
         m_points.emplace_back(uid);
+        CommandJournal::recordAdd(uid);
     }
 } // namespace Bess::Simulator::Components
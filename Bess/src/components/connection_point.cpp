@@ -20,11 +20,11 @@ namespace Bess::Simulator::Components {
 
     void ConnectionPoint::render() {
         float r = 3.0f;
-        if (m_isHovered || m_isSelected) {
+        if (isHovered() || isSelected() || m_connectionSelected) {
             r = 4.5f;
-            Renderer2D::Renderer::circle(m_transform.getPosition(), r + 1.f, ViewportTheme::selectedWireColor, m_renderId);
+            Renderer2D::Renderer::circle(transform().getPosition(), r + 1.f, ViewportTheme::selectedWireColor, m_renderId);
         }
-        Renderer2D::Renderer::circle(m_transform.getPosition(), r, ViewportTheme::wireColor, m_renderId);
+        Renderer2D::Renderer::circle(transform().getPosition(), r, ViewportTheme::wireColor, m_renderId);
     }
 
     void ConnectionPoint::deleteComponent() {
@@ -38,7 +38,7 @@ namespace Bess::Simulator::Components {
     void ConnectionPoint::drawProperties() {}
 
     void ConnectionPoint::setSelected(bool selected) {
-        m_isSelected = selected;
+        m_connectionSelected = selected;
     }
 
     void ConnectionPoint::fromJson(const nlohmann::json &j) {
@@ -61,7 +61,7 @@ namespace Bess::Simulator::Components {
         j["type"] = (int)ComponentType::connectionPoint;
         j["uid"] = getIdStr();
         j["parentSlots"] = ComponentsManager::getSlotsForConnection(m_parentId);
-        j["position"] = Common::Helpers::EncodeVec3(m_transform.getPosition());
+        j["position"] = Common::Helpers::EncodeVec3(transform().getPosition());
         return j;
     }
 
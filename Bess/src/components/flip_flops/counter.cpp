@@ -0,0 +1,51 @@
+#include "components/flip_flops/counter.h"
+#include "imgui.h"
+
+namespace Bess::Simulator::Components {
+    Counter::Counter(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots)
+        : FlipFlop(uid, renderId, position, inputSlots, defaultWidth) {
+        m_name = name;
+        addToNetlist(NodeKind::counter);
+    }
+
+    Counter::Counter(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, std::vector<uuids::uuid> outputSlots, uuids::uuid clockSlot)
+        : FlipFlop(uid, renderId, position, inputSlots, name, outputSlots, clockSlot) {
+        addToNetlist(NodeKind::counter);
+    }
+
+    void Counter::generate(const glm::vec3 &pos) {
+        FlipFlop::generate<Counter>(3, pos);
+    }
+
+    void Counter::drawProperties() {
+        ImGui::Text("%d-bit Up/Down Counter", getWidth());
+        int width = getWidth();
+        if (drawWidthProperty("Width", width, 1, maxWidth))
+            setWidth(width);
+        drawClockEdgeProperty();
+    }
+
+    nlohmann::json Counter::toJson() {
+        auto data = FlipFlop::toJson();
+        data["width"] = getWidth();
+        return data;
+    }
+
+    int Counter::getWidth() const {
+        return static_cast<int>(m_outputSlots.size());
+    }
+
+    void Counter::setWidth(int width) {
+        m_outputSlots = resizeSlots(m_outputSlots, width, ComponentType::outputSlot);
+        addToNetlist(NodeKind::counter);
+    }
+
+    std::string Counter::getInputLabel(int index) const {
+        static const std::string labels[] = {"EN", "DWN", "RST"};
+        return index < 3 ? labels[index] : "";
+    }
+
+    std::string Counter::getOutputLabel(int index) const {
+        return "Q" + std::to_string(index);
+    }
+} // namespace Bess::Simulator::Components
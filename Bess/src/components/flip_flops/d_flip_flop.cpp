@@ -5,6 +5,12 @@ namespace Bess::Simulator::Components {
     DFlipFlop::DFlipFlop(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots)
         : FlipFlop(uid, renderId, position, inputSlots) {
         m_name = name;
+        addToNetlist(NodeKind::dFlipFlop);
+    }
+
+    DFlipFlop::DFlipFlop(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, std::vector<uuids::uuid> outputSlots, uuids::uuid clockSlot)
+        : FlipFlop(uid, renderId, position, inputSlots, name, outputSlots, clockSlot) {
+        addToNetlist(NodeKind::dFlipFlop);
     }
 
     void DFlipFlop::update() {
@@ -16,8 +22,8 @@ namespace Bess::Simulator::Components {
     }
 
     void DFlipFlop::drawProperties() {
+        ImGui::Text("D Flip Flop");
+        drawClockEdgeProperty();
     }
 
-    void DFlipFlop::simulate() {}
-
 } // namespace Bess::Simulator::Components
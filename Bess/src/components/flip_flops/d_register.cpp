@@ -0,0 +1,51 @@
+#include "components/flip_flops/d_register.h"
+#include "imgui.h"
+
+namespace Bess::Simulator::Components {
+    DRegister::DRegister(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots)
+        : FlipFlop(uid, renderId, position, inputSlots, static_cast<int>(inputSlots.size())) {
+        m_name = name;
+        addToNetlist(NodeKind::dRegister);
+    }
+
+    DRegister::DRegister(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, std::vector<uuids::uuid> outputSlots, uuids::uuid clockSlot)
+        : FlipFlop(uid, renderId, position, inputSlots, name, outputSlots, clockSlot) {
+        addToNetlist(NodeKind::dRegister);
+    }
+
+    void DRegister::generate(const glm::vec3 &pos) {
+        FlipFlop::generate<DRegister>(defaultWidth, pos);
+    }
+
+    void DRegister::drawProperties() {
+        ImGui::Text("%d-bit D Register", getWidth());
+        int width = getWidth();
+        if (drawWidthProperty("Width", width, 1, maxWidth))
+            setWidth(width);
+        drawClockEdgeProperty();
+    }
+
+    nlohmann::json DRegister::toJson() {
+        auto data = FlipFlop::toJson();
+        data["width"] = getWidth();
+        return data;
+    }
+
+    int DRegister::getWidth() const {
+        return static_cast<int>(m_outputSlots.size());
+    }
+
+    void DRegister::setWidth(int width) {
+        m_inputSlots = resizeSlots(m_inputSlots, width, ComponentType::inputSlot);
+        m_outputSlots = resizeSlots(m_outputSlots, width, ComponentType::outputSlot);
+        addToNetlist(NodeKind::dRegister);
+    }
+
+    std::string DRegister::getInputLabel(int index) const {
+        return "D" + std::to_string(index);
+    }
+
+    std::string DRegister::getOutputLabel(int index) const {
+        return "Q" + std::to_string(index);
+    }
+} // namespace Bess::Simulator::Components
@@ -5,13 +5,17 @@
 #include "components/flip_flops/jk_flip_flop.h"
 #include "components/slot.h"
 #include "components_manager/components_manager.h"
+#include "imgui.h"
 #include "pages/main_page/main_page_state.h"
 #include "scene/renderer/renderer.h"
+#include "scene/spatial_index.h"
 #include "settings/viewport_theme.h"
+#include "simulator/simulator_engine.h"
+#include "ui/m_widgets.h"
 #include "uuid.h"
 
 namespace Bess::Simulator::Components {
-    FlipFlop::FlipFlop(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots)
+    FlipFlop::FlipFlop(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, int outputCount)
         : Component(uid, renderId, position, ComponentType::flipFlop), m_inputSlots(inputSlots) {
 
         auto clkRenderId = ComponentsManager::getNextRenderId();
@@ -20,7 +24,7 @@ namespace Bess::Simulator::Components {
         ComponentsManager::addCompIdToRId(clkRenderId, m_clockSlot);
         ComponentsManager::addRenderIdToCId(clkRenderId, m_clockSlot);
 
-        for (int i = 0; i < 2; i++) {
+        for (int i = 0; i < outputCount; i++) {
             auto sid = Common::Helpers::uuidGenerator.getUUID();
             auto renderId = ComponentsManager::getNextRenderId();
             ComponentsManager::components[sid] = std::make_shared<Components::Slot>(sid, uid, renderId, ComponentType::outputSlot);
@@ -33,7 +37,67 @@ namespace Bess::Simulator::Components {
             Pages::MainPageState::getInstance()->setBulkId(m_uid);
         };
 
-        m_transform.setScale({140.f, 100.f});
+        transform().setScale({140.f, 100.f});
+    }
+
+    void FlipFlop::addToNetlist(NodeKind kind) {
+        Simulator::Engine::push([uid = m_uid, kind, inputs = m_inputSlots, outputs = m_outputSlots, clock = m_clockSlot, edge = m_clockEdge](Netlist &netlist) {
+            int node = netlist.addNode(uid, kind, inputs, outputs, clock);
+            netlist.setClockEdge(node, edge);
+        });
+    }
+
+    ClockEdge FlipFlop::getClockEdge() const {
+        return m_clockEdge;
+    }
+
+    void FlipFlop::setClockEdge(ClockEdge edge) {
+        m_clockEdge = edge;
+        Simulator::Engine::push([uid = m_uid, edge](Netlist &netlist) {
+            int node = netlist.getNodeId(uid);
+            if (node != Netlist::invalidId)
+                netlist.setClockEdge(node, edge);
+        });
+    }
+
+    std::vector<uuids::uuid> FlipFlop::resizeSlots(const std::vector<uuids::uuid> &slots, int count, ComponentType type) {
+        std::vector<uuids::uuid> resized(slots.begin(), slots.begin() + std::min<size_t>(count, slots.size()));
+        for (size_t i = resized.size(); i < slots.size(); i++) {
+            // the wires go first so the journal keeps them
+            for (auto &connection : ComponentsManager::getSlotConnections(slots[i]))
+                ComponentsManager::deleteComponent(connection);
+            ComponentsManager::deleteComponent(slots[i]);
+        }
+
+        while (resized.size() < count) {
+            auto sid = Common::Helpers::uuidGenerator.getUUID();
+            auto renderId = ComponentsManager::getNextRenderId();
+            ComponentsManager::components[sid] = std::make_shared<Components::Slot>(sid, m_uid, renderId, type);
+            ComponentsManager::addCompIdToRId(renderId, sid);
+            ComponentsManager::addRenderIdToCId(renderId, sid);
+            resized.emplace_back(sid);
+        }
+        // the component grows or shrinks with its slots
+        Scene::SpatialIndex::invalidate(m_renderId);
+        return resized;
+    }
+
+    bool FlipFlop::drawWidthProperty(const char *label, int &width, int min, int max) {
+        // typed values apply on enter, the slots are rebuilt on every change
+        const int prev = width;
+        if (!ImGui::InputInt(label, &width, 1, 1, ImGuiInputTextFlags_EnterReturnsTrue))
+            return false;
+        width = std::clamp(width, min, max);
+        return width != prev;
+    }
+
+    void FlipFlop::drawClockEdgeProperty() {
+        std::vector<std::string> edges = {"Rising", "Falling"};
+        std::string currEdge = edges[(int)m_clockEdge];
+        if (UI::MWidgets::ComboBox("Clock Edge", currEdge, edges)) {
+            auto idx = std::distance(edges.begin(), std::find(edges.begin(), edges.end(), currEdge));
+            setClockEdge(static_cast<ClockEdge>(idx));
+        }
     }
 
     FlipFlop::FlipFlop(const uuids::uuid &uid, int renderId, const glm::vec3 &position, const std::vector<uuids::uuid> &inputSlots, const std::string &name, const std::vector<uuids::uuid> &outputSlots, const uuids::uuid &clockSlot)
@@ -45,12 +109,12 @@ namespace Bess::Simulator::Components {
         m_events[ComponentEventType::leftClick] = (OnLeftClickCB)[this](auto pos) {
             Pages::MainPageState::getInstance()->setBulkId(m_uid);
         };
-        m_transform.setScale({140.f, 100.f});
+        transform().setScale({140.f, 100.f});
     }
 
     void FlipFlop::drawBackground(const glm::vec4 &borderThicknessPx, float rPx, float headerHeight, const glm::vec2 &gateSize) {
-        auto borderColor = m_isSelected ? ViewportTheme::selectedCompColor : ViewportTheme::componentBorderColor;
-        auto pos = m_transform.getPosition();
+        auto borderColor = isSelected() ? ViewportTheme::selectedCompColor : ViewportTheme::componentBorderColor;
+        auto pos = transform().getPosition();
         auto color = ViewportTheme::componentBGColor;
 
         Renderer2D::Renderer::quad(
@@ -97,7 +161,7 @@ namespace Bess::Simulator::Components {
 
         maxWidth += labelGap + 8.f + sampleCharSize.x + 16.f + (gatePadding.x * 2.f);
 
-        auto gateSize_ = m_transform.getScale();
+        auto gateSize_ = transform().getScale();
 
         if (maxWidth > gateSize_.x) {
             gateSize_.x += maxWidth - gateSize_.x + 16.f;
@@ -107,21 +171,14 @@ namespace Bess::Simulator::Components {
 
         drawBackground(borderThicknessPx, rPx, headerHeight, gateSize_);
 
-        char startChar = 'A';
-        if (m_name == JKFlipFlop::name) {
-            startChar = 'J';
-        } else if (m_name == DFlipFlop::name) {
-            startChar = 'D';
-        }
-
-        auto leftCornerPos = Common::Helpers::GetLeftCornerPos(m_transform.getPosition(), gateSize_);
+        auto leftCornerPos = Common::Helpers::GetLeftCornerPos(transform().getPosition(), gateSize_);
 
         {
             glm::vec3 inpSlotRowPos = {leftCornerPos.x + 8.f + gatePadding.x, leftCornerPos.y + headerHeight + 4.f, leftCornerPos.z};
 
+            // the clock sits after the first half of the inputs, at least one
+            const size_t clockRow = std::max<size_t>(m_inputSlots.size() / 2, 1);
             for (int i = 0; i < m_inputSlots.size(); i++) {
-                char ch = startChar + i;
-
                 auto height = (slotRowPadding.y * 2) + sCharHeight;
 
                 auto pos = inpSlotRowPos;
@@ -129,12 +186,12 @@ namespace Bess::Simulator::Components {
                 pos.z += ComponentsManager::zIncrement / 10;
 
                 Slot *slot = (Slot *)Simulator::ComponentsManager::components[m_inputSlots[i]].get();
-                slot->update(pos, {labelGap, 0.f}, std::string(1, ch));
+                slot->update(pos, {labelGap, 0.f}, getInputLabel(i));
                 slot->render();
 
                 inpSlotRowPos.y += height + rowGap;
 
-                if ((i + 1) == (m_inputSlots.size() / 2)) {
+                if ((i + 1) == clockRow) {
                     pos = inpSlotRowPos;
                     pos.y += height / 2.f;
                     pos.z += ComponentsManager::zIncrement / 10;
@@ -157,7 +214,7 @@ namespace Bess::Simulator::Components {
                 pos.z += ComponentsManager::zIncrement / 10;
 
                 Slot *slot = (Slot *)Simulator::ComponentsManager::components[m_outputSlots[i]].get();
-                slot->update(pos, {-labelGap, 0.f}, (i == 0) ? "Q" : "Q'");
+                slot->update(pos, {-labelGap, 0.f}, getOutputLabel(i));
                 slot->render();
 
                 outSlotRowPos.y += height + rowGap;
@@ -171,21 +228,46 @@ namespace Bess::Simulator::Components {
         Component::update();
     }
 
+    std::string FlipFlop::getInputLabel(int index) const {
+        char startChar = 'A';
+        if (m_name == JKFlipFlop::name) {
+            startChar = 'J';
+        } else if (m_name == DFlipFlop::name) {
+            startChar = 'D';
+        }
+        return std::string(1, static_cast<char>(startChar + index));
+    }
+
+    std::string FlipFlop::getOutputLabel(int index) const {
+        return index == 0 ? "Q" : "Q'";
+    }
+
+    std::vector<uuids::uuid> FlipFlop::getSlots(ComponentType slotType) const {
+        if (slotType == ComponentType::outputSlot)
+            return m_outputSlots;
+        auto slots = m_inputSlots;
+        slots.emplace_back(m_clockSlot);
+        return slots;
+    }
+
+    std::string FlipFlop::getSlotLabel(ComponentType slotType, int index) const {
+        if (slotType == ComponentType::outputSlot)
+            return getOutputLabel(index);
+        return index == m_inputSlots.size() ? "CLK" : getInputLabel(index);
+    }
+
     void FlipFlop::generate(const glm::vec3 &pos) {}
 
     void FlipFlop::deleteComponent() {
         for (auto &slot : m_inputSlots) {
-            auto comp = ComponentsManager::components[slot];
-            comp->deleteComponent();
+            ComponentsManager::deleteComponent(slot);
         }
 
         for (auto &slot : m_outputSlots) {
-            auto comp = ComponentsManager::components[slot];
-            comp->deleteComponent();
+            ComponentsManager::deleteComponent(slot);
         }
 
-        auto comp = ComponentsManager::components[m_clockSlot];
-        comp->deleteComponent();
+        ComponentsManager::deleteComponent(m_clockSlot);
     }
 
     void FlipFlop::fromJson(const nlohmann::json &data) {
@@ -215,15 +297,27 @@ namespace Bess::Simulator::Components {
 
         if (name == JKFlipFlop::name)
             ComponentsManager::components[uid] = std::make_shared<JKFlipFlop>(uid, renderId, pos, inputSlots, outputSlots, sid);
-        // else if (name == DFlipFlop::name)
-        //     ComponentsManager::components[uid] = std::make_shared<DFlipFlop>(uid, ComponentsManager::getNextRenderId(), pos, inputSlots, outputSlots, clkSlot);
+        else if (name == DFlipFlop::name)
+            ComponentsManager::components[uid] = std::make_shared<DFlipFlop>(uid, renderId, pos, inputSlots, outputSlots, sid);
+        else if (name == DRegister::name)
+            ComponentsManager::components[uid] = std::make_shared<DRegister>(uid, renderId, pos, inputSlots, outputSlots, sid);
+        else if (name == Counter::name)
+            ComponentsManager::components[uid] = std::make_shared<Counter>(uid, renderId, pos, inputSlots, outputSlots, sid);
+        else if (name == ShiftRegister::name)
+            ComponentsManager::components[uid] = std::make_shared<ShiftRegister>(uid, renderId, pos, inputSlots, outputSlots, sid);
+        else if (name == RegisterFile::name)
+            ComponentsManager::components[uid] = std::make_shared<RegisterFile>(uid, renderId, pos, inputSlots, outputSlots, sid);
+
+        auto flipFlop = ComponentsManager::getComponent<FlipFlop>(uid);
+        if (flipFlop && data.contains("clockEdge"))
+            flipFlop->setClockEdge(static_cast<ClockEdge>(data["clockEdge"].get<int>()));
     }
 
     nlohmann::json FlipFlop::toJson() {
         nlohmann::json data;
         data["type"] = (int)m_type;
         data["uid"] = Common::Helpers::uuidToStr(m_uid);
-        data["pos"] = Common::Helpers::EncodeVec3(m_transform.getPosition());
+        data["pos"] = Common::Helpers::EncodeVec3(transform().getPosition());
         data["name"] = m_name;
 
         nlohmann::json inputSlots;
@@ -241,6 +335,7 @@ namespace Bess::Simulator::Components {
         data["outputSlots"] = outputSlots;
 
         data["clockSlot"] = ComponentsManager::getComponent<Slot>(m_clockSlot)->toJson();
+        data["clockEdge"] = (int)m_clockEdge;
 
         return data;
     }
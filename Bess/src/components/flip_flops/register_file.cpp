@@ -0,0 +1,82 @@
+#include "components/flip_flops/register_file.h"
+#include "imgui.h"
+
+namespace Bess::Simulator::Components {
+    RegisterFile::RegisterFile(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots)
+        : FlipFlop(uid, renderId, position, inputSlots, defaultWidth) {
+        m_name = name;
+        addToNetlist(NodeKind::registerFile);
+    }
+
+    RegisterFile::RegisterFile(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, std::vector<uuids::uuid> outputSlots, uuids::uuid clockSlot)
+        : FlipFlop(uid, renderId, position, inputSlots, name, outputSlots, clockSlot) {
+        addToNetlist(NodeKind::registerFile);
+    }
+
+    void RegisterFile::generate(const glm::vec3 &pos) {
+        FlipFlop::generate<RegisterFile>(defaultWidth + 2 * defaultAddressBits + 1, pos);
+    }
+
+    void RegisterFile::drawProperties() {
+        ImGui::Text("%d x %d-bit Register File", 1 << getAddressBits(), getWidth());
+        int width = getWidth(), addressBits = getAddressBits();
+        if (drawWidthProperty("Width", width, 1, maxWidth))
+            resize(width, addressBits);
+        if (drawWidthProperty("Address Bits", addressBits, 1, maxAddressBits))
+            resize(width, addressBits);
+        drawClockEdgeProperty();
+    }
+
+    nlohmann::json RegisterFile::toJson() {
+        auto data = FlipFlop::toJson();
+        data["width"] = getWidth();
+        data["addressBits"] = getAddressBits();
+        return data;
+    }
+
+    int RegisterFile::getWidth() const {
+        return static_cast<int>(m_outputSlots.size());
+    }
+
+    int RegisterFile::getAddressBits() const {
+        return (static_cast<int>(m_inputSlots.size()) - static_cast<int>(m_outputSlots.size()) - 1) / 2;
+    }
+
+    void RegisterFile::resize(int width, int addressBits) {
+        // D, WA, WE and RA are resized on their own, the slots that stay keep their wires
+        const int oldWidth = getWidth(), oldAddressBits = getAddressBits();
+        auto section = [&](int start, int count) {
+            return std::vector<uuids::uuid>(m_inputSlots.begin() + start, m_inputSlots.begin() + start + count);
+        };
+        auto data = section(0, oldWidth);
+        auto writeAddress = section(oldWidth, oldAddressBits);
+        auto writeEnable = m_inputSlots[oldWidth + oldAddressBits];
+        auto readAddress = section(oldWidth + oldAddressBits + 1, oldAddressBits);
+
+        m_inputSlots = resizeSlots(data, width, ComponentType::inputSlot);
+        for (auto &slot : resizeSlots(writeAddress, addressBits, ComponentType::inputSlot))
+            m_inputSlots.emplace_back(slot);
+        m_inputSlots.emplace_back(writeEnable);
+        for (auto &slot : resizeSlots(readAddress, addressBits, ComponentType::inputSlot))
+            m_inputSlots.emplace_back(slot);
+        m_outputSlots = resizeSlots(m_outputSlots, width, ComponentType::outputSlot);
+        addToNetlist(NodeKind::registerFile);
+    }
+
+    std::string RegisterFile::getInputLabel(int index) const {
+        const int width = static_cast<int>(m_outputSlots.size());
+        const int addressBits = getAddressBits();
+        if (index < width)
+            return "D" + std::to_string(index);
+        index -= width;
+        if (index < addressBits)
+            return "WA" + std::to_string(index);
+        if (index == addressBits)
+            return "WE";
+        return "RA" + std::to_string(index - addressBits - 1);
+    }
+
+    std::string RegisterFile::getOutputLabel(int index) const {
+        return "Q" + std::to_string(index);
+    }
+} // namespace Bess::Simulator::Components
@@ -0,0 +1,50 @@
+#include "components/flip_flops/shift_register.h"
+#include "imgui.h"
+
+namespace Bess::Simulator::Components {
+    ShiftRegister::ShiftRegister(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots)
+        : FlipFlop(uid, renderId, position, inputSlots, defaultWidth) {
+        m_name = name;
+        addToNetlist(NodeKind::shiftRegister);
+    }
+
+    ShiftRegister::ShiftRegister(const uuids::uuid &uid, int renderId, glm::vec3 position, std::vector<uuids::uuid> inputSlots, std::vector<uuids::uuid> outputSlots, uuids::uuid clockSlot)
+        : FlipFlop(uid, renderId, position, inputSlots, name, outputSlots, clockSlot) {
+        addToNetlist(NodeKind::shiftRegister);
+    }
+
+    void ShiftRegister::generate(const glm::vec3 &pos) {
+        FlipFlop::generate<ShiftRegister>(2, pos);
+    }
+
+    void ShiftRegister::drawProperties() {
+        ImGui::Text("%d-bit Shift Register", getWidth());
+        int width = getWidth();
+        if (drawWidthProperty("Width", width, 1, maxWidth))
+            setWidth(width);
+        drawClockEdgeProperty();
+    }
+
+    nlohmann::json ShiftRegister::toJson() {
+        auto data = FlipFlop::toJson();
+        data["width"] = getWidth();
+        return data;
+    }
+
+    int ShiftRegister::getWidth() const {
+        return static_cast<int>(m_outputSlots.size());
+    }
+
+    void ShiftRegister::setWidth(int width) {
+        m_outputSlots = resizeSlots(m_outputSlots, width, ComponentType::outputSlot);
+        addToNetlist(NodeKind::shiftRegister);
+    }
+
+    std::string ShiftRegister::getInputLabel(int index) const {
+        return index == 0 ? "SI" : "EN";
+    }
+
+    std::string ShiftRegister::getOutputLabel(int index) const {
+        return "Q" + std::to_string(index);
+    }
+} // namespace Bess::Simulator::Components
@@ -4,6 +4,8 @@
 #include "pages/main_page/main_page_state.h"
 #include "scene/renderer/renderer.h"
 #include "settings/viewport_theme.h"
+#include "simulator/simulator_engine.h"
+#include "ui/m_widgets.h"
 
 namespace Bess::Simulator::Components {
     InputProbe::InputProbe() : Component() {
@@ -15,7 +17,8 @@ namespace Bess::Simulator::Components {
         m_name = "Input Probe";
         m_outputSlot = outputSlot;
         m_events[ComponentEventType::leftClick] = (OnLeftClickCB)BIND_FN_1(InputProbe::onLeftClick);
-        m_transform.setScale({65.f, 25.f});
+        transform().setScale({65.f, 25.f});
+        Simulator::Engine::push([uid = m_uid, slot = m_outputSlot](Netlist &netlist) { netlist.addNode(uid, NodeKind::inputProbe, {}, {slot}); });
     }
 
     void InputProbe::render() {
@@ -33,12 +36,12 @@ namespace Bess::Simulator::Components {
 
         std::string label = (isHigh) ? "On" : "Off";
 
-        if (m_isSelected) {
+        if (isSelected()) {
             borderColor = ViewportTheme::selectedCompColor;
         }
 
-        auto pos = m_transform.getPosition();
-        auto size = m_transform.getScale();
+        auto pos = transform().getPosition();
+        auto size = transform().getScale();
 
         Renderer2D::Renderer::quad(pos, size, bgColor, m_renderId, glm::vec4(r), true, borderColor, thickness);
 
@@ -70,13 +73,31 @@ namespace Bess::Simulator::Components {
         ComponentsManager::renderComponents.emplace_back(uid);
     }
 
+    const uuids::uuid& InputProbe::getOutputSlot() const {
+        return m_outputSlot;
+    }
+
+    const std::string &InputProbe::getLabel() const {
+        return m_label;
+    }
+
+    void InputProbe::setLabel(const std::string &label) {
+        m_label = label;
+    }
+
+    void InputProbe::drawProperties() {
+        UI::MWidgets::TextBox("Label", m_label, "Name in test vectors");
+    }
+
     nlohmann::json InputProbe::toJson() {
         nlohmann::json data;
         data["uid"] = Common::Helpers::uuidToStr(m_uid);
         data["type"] = (int)m_type;
-        data["pos"] = Common::Helpers::EncodeVec3(m_transform.getPosition());
+        data["pos"] = Common::Helpers::EncodeVec3(transform().getPosition());
         auto slot = (Slot *)ComponentsManager::components[m_outputSlot].get();
         data["slot"] = slot->toJson();
+        if (!m_label.empty())
+            data["label"] = m_label;
         return data;
     }
 
@@ -90,22 +111,14 @@ namespace Bess::Simulator::Components {
 
         auto renderId = ComponentsManager::getNextRenderId();
 
-        ComponentsManager::components[uid] = std::make_shared<Components::InputProbe>(uid, renderId, pos, slotId);
+        auto probe = std::make_shared<Components::InputProbe>(uid, renderId, pos, slotId);
+        probe->setLabel(data.value("label", ""));
+        ComponentsManager::components[uid] = probe;
         ComponentsManager::addRenderIdToCId(renderId, uid);
         ComponentsManager::addCompIdToRId(renderId, uid);
         ComponentsManager::renderComponents.emplace_back(uid);
     }
 
-    void InputProbe::simulate() const {
-        auto slot = (Slot *)ComponentsManager::components[m_outputSlot].get();
-        slot->simulate(m_uid, slot->getState());
-    }
-
-    void InputProbe::refresh() const {
-        auto slot = (Slot *)ComponentsManager::components[m_outputSlot].get();
-        slot->refresh(m_uid, slot->getState());
-    }
-
     void InputProbe::onLeftClick(const glm::vec2 &pos) {
         Pages::MainPageState::getInstance()->setBulkId(m_uid);
         auto slot = (Slot *)ComponentsManager::components[m_outputSlot].get();
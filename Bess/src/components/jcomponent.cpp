@@ -35,15 +35,27 @@ namespace Bess::Simulator::Components {
         m_events[ComponentEventType::rightClick] =
             (OnRightClickCB)BIND_EVENT_FN_1(onRightClick);
 
-        m_transform.setScale({142.f, 100.f});
+        transform().setScale({142.f, 100.f});
 
-        simulate();
+        if (m_data->isWord()) {
+            for (int i = 0; i < m_inputSlots.size(); i++)
+                ComponentsManager::getComponent<Slot>(m_inputSlots[i])->setWidth(m_data->getInputWidth(i));
+            for (int i = 0; i < m_outputSlots.size(); i++)
+                ComponentsManager::getComponent<Slot>(m_outputSlots[i])->setWidth(m_data->getOutputWidth(i));
+        }
+
+        Simulator::Engine::push([uid = m_uid, inputs = m_inputSlots, outputs = m_outputSlots, data = m_data.get()](Netlist &netlist) {
+            netlist.addNode(uid, NodeKind::jcomponent, inputs, outputs, {}, data);
+        });
     }
 
+
     void JComponent::drawBackground(const glm::vec4 &borderThicknessPx, float rPx, float headerHeight, const glm::vec2 &gateSize) {
-        auto borderColor = m_isSelected ? ViewportTheme::selectedCompColor : ViewportTheme::componentBorderColor;
+        auto borderColor = isSelected() ? ViewportTheme::selectedCompColor : ViewportTheme::componentBorderColor;
+        if (!isSelected() && Simulator::Engine::isOscillating(m_uid))
+            borderColor = ViewportTheme::oscillatingColor;
         auto color = ViewportTheme::componentBGColor;
-        auto pos = m_transform.getPosition();
+        auto pos = transform().getPosition();
 
         Renderer2D::Renderer::quad(
             {pos.x, pos.y + headerHeight / 2.f, pos.z},
@@ -73,8 +85,14 @@ namespace Bess::Simulator::Components {
 
     std::string decodeExpr(const std::string &str) {
         std::string exp = "";
+        // digits of a word literal (#12, #0xff) are kept as they are
+        bool literal = false;
         for (auto ch : str) {
-            if (std::isdigit(ch))
+            if (ch == '#')
+                literal = true;
+            else if (!std::isalnum(ch))
+                literal = false;
+            else if (std::isdigit(ch) && !literal)
                 ch = 'A' + (ch - '0');
             exp += ch;
         }
@@ -102,7 +120,7 @@ namespace Bess::Simulator::Components {
 
         maxWidth += labelGap + 8.f + 16.f + sampleCharSize.x + (gatePadding.x * 2.f);
 
-        auto gateSize_ = m_transform.getScale();
+        auto gateSize_ = transform().getScale();
 
         gateSize_.x = maxWidth + 16.f;
 
@@ -111,14 +129,12 @@ namespace Bess::Simulator::Components {
 
         drawBackground(borderThicknessPx, rPx, headerHeight, gateSize_);
 
-        auto leftCornerPos = Common::Helpers::GetLeftCornerPos(m_transform.getPosition(), gateSize_);
+        auto leftCornerPos = Common::Helpers::GetLeftCornerPos(transform().getPosition(), gateSize_);
 
         {
             glm::vec3 inpSlotRowPos = {leftCornerPos.x + 8.f + gatePadding.x, leftCornerPos.y + headerHeight + 4.f, leftCornerPos.z};
 
             for (int i = 0; i < m_inputSlots.size(); i++) {
-                char ch = 'A' + i;
-
                 auto height = (slotRowPadding.y * 2) + sCharHeight;
 
                 auto pos = inpSlotRowPos;
@@ -126,7 +142,7 @@ namespace Bess::Simulator::Components {
                 pos.z += ComponentsManager::zIncrement / 10;
 
                 Slot *slot = (Slot *)Simulator::ComponentsManager::components[m_inputSlots[i]].get();
-                slot->update(pos, {labelGap, 0.f}, std::string(1, ch));
+                slot->update(pos, {labelGap, 0.f}, getSlotLabel(ComponentType::inputSlot, i));
                 slot->render();
 
                 inpSlotRowPos.y += height + rowGap;
@@ -144,8 +160,7 @@ namespace Bess::Simulator::Components {
                 pos.z += ComponentsManager::zIncrement / 10;
 
                 Slot *slot = (Slot *)Simulator::ComponentsManager::components[m_outputSlots[i]].get();
-                auto &expr = m_data->getOutputs()[i];
-                slot->update(pos, {-labelGap, 0.f}, decodeExpr(expr));
+                slot->update(pos, {-labelGap, 0.f}, getSlotLabel(ComponentType::outputSlot, i));
                 slot->render();
 
                 outSlotRowPos.y += height + rowGap;
@@ -155,28 +170,6 @@ namespace Bess::Simulator::Components {
         Renderer2D::Renderer::text(m_name, leftCornerPos + glm::vec3({8.f, 8.f + (sCharHeight / 2.f), ComponentsManager::zIncrement}), 11.f, ViewportTheme::textColor, m_renderId);
     }
 
-    void JComponent::simulate() {
-        std::vector<int> inputs = {};
-        std::vector<int> outputs = {};
-
-        for (auto &slotId : m_inputSlots) {
-            auto slot = (Slot *)ComponentsManager::components[slotId].get();
-            auto v = static_cast<std::underlying_type_t<DigitalState>>(slot->getState());
-            inputs.emplace_back(v);
-        }
-
-        for (auto &exp : m_data->getOutputs()) {
-            int v = Simulator::Engine::evaluateExpression(exp, inputs);
-            outputs.emplace_back(v);
-        }
-
-        for (int i = 0; i < outputs.size(); i++) {
-            auto &slotId = m_outputSlots[i];
-            DigitalState outputState = static_cast<DigitalState>(outputs[i]);
-            Simulator::Engine::addToSimQueue(slotId, m_uid, outputState);
-        }
-    }
-
     void JComponent::generate(const glm::vec3 &pos) {
     }
 
@@ -232,11 +225,35 @@ namespace Bess::Simulator::Components {
         }
     }
 
+    const std::shared_ptr<JComponentData> &JComponent::getData() const {
+        return m_data;
+    }
+
+    const std::vector<uuids::uuid> &JComponent::getInputSlots() const {
+        return m_inputSlots;
+    }
+
+    const std::vector<uuids::uuid> &JComponent::getOutputSlots() const {
+        return m_outputSlots;
+    }
+
+    std::vector<uuids::uuid> JComponent::getSlots(ComponentType slotType) const {
+        return slotType == ComponentType::inputSlot ? m_inputSlots : m_outputSlots;
+    }
+
+    std::string JComponent::getSlotLabel(ComponentType slotType, int index) const {
+        if (slotType == ComponentType::inputSlot)
+            return std::string(1, 'A' + index);
+        auto &expr = m_data->getOutputs()[index];
+        // subcircuit outputs are labels, not expressions
+        return m_data->isSubcircuit() ? expr : decodeExpr(expr);
+    }
+
     nlohmann::json JComponent::toJson() {
         nlohmann::json data;
 
         data["uid"] = Common::Helpers::uuidToStr(m_uid);
-        data["pos"] = Common::Helpers::EncodeVec3(m_transform.getPosition());
+        data["pos"] = Common::Helpers::EncodeVec3(transform().getPosition());
         data["type"] = (int)m_type;
 
         data["jCompData"]["collection"] = m_data->getCollectionName();
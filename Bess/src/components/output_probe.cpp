@@ -5,6 +5,9 @@
 #include "pages/main_page/main_page_state.h"
 #include "scene/renderer/renderer.h"
 #include "settings/viewport_theme.h"
+#include "simulator/simulator_engine.h"
+#include "ui/m_widgets.h"
+
 
 namespace Bess::Simulator::Components {
 
@@ -20,7 +23,8 @@ namespace Bess::Simulator::Components {
             (OnLeftClickCB)[&](const glm::vec2 &pos) {
             Pages::MainPageState::getInstance()->setBulkId(m_uid);
         };
-        m_transform.setScale({50.f, 25.f});
+        transform().setScale({50.f, 25.f});
+        Simulator::Engine::push([uid = m_uid, slot = m_inputSlot](Netlist &netlist) { netlist.addNode(uid, NodeKind::outputProbe, {slot}, {}); });
     }
 
     void OutputProbe::render() {
@@ -36,14 +40,14 @@ namespace Bess::Simulator::Components {
 
         std::string label = (isHigh) ? "H" : "L";
 
-        if (m_isSelected) {
+        if (isSelected()) {
             borderColor = ViewportTheme::selectedCompColor;
         } else if (isHigh) {
             borderColor = ViewportTheme::stateHighColor;
         }
 
-        auto pos = m_transform.getPosition();
-        auto size = m_transform.getScale();
+        auto pos = transform().getPosition();
+        auto size = transform().getScale();
 
         Renderer2D::Renderer::quad(
             pos,
@@ -86,13 +90,31 @@ namespace Bess::Simulator::Components {
         ComponentsManager::renderComponents.emplace_back(uid);
     }
 
+    const uuids::uuid &OutputProbe::getInputSlot() const {
+        return m_inputSlot;
+    }
+
+    const std::string &OutputProbe::getLabel() const {
+        return m_label;
+    }
+
+    void OutputProbe::setLabel(const std::string &label) {
+        m_label = label;
+    }
+
+    void OutputProbe::drawProperties() {
+        UI::MWidgets::TextBox("Label", m_label, "Name in test vectors");
+    }
+
     nlohmann::json OutputProbe::toJson() {
         nlohmann::json data;
         data["uid"] = Common::Helpers::uuidToStr(m_uid);
         data["type"] = (int)m_type;
-        data["pos"] = Common::Helpers::EncodeVec3(m_transform.getPosition());
+        data["pos"] = Common::Helpers::EncodeVec3(transform().getPosition());
         auto slot = (Slot *)ComponentsManager::components[m_inputSlot].get();
         data["slot"] = slot->toJson();
+        if (!m_label.empty())
+            data["label"] = m_label;
         return data;
     }
 
@@ -106,7 +128,9 @@ namespace Bess::Simulator::Components {
 
         auto renderId = ComponentsManager::getNextRenderId();
 
-        ComponentsManager::components[uid] = std::make_shared<Components::OutputProbe>(uid, renderId, pos, slotId);
+        auto probe = std::make_shared<Components::OutputProbe>(uid, renderId, pos, slotId);
+        probe->setLabel(data.value("label", ""));
+        ComponentsManager::components[uid] = probe;
         ComponentsManager::addRenderIdToCId(renderId, uid);
         ComponentsManager::addCompIdToRId(renderId, uid);
         ComponentsManager::renderComponents.emplace_back(uid);
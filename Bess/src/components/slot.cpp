@@ -20,38 +20,38 @@ namespace Bess::Simulator::Components {
         : Component(uid, id, {0.f, 0.f, 0.f}, type), m_parentUid{parentUid} {
         m_events[ComponentEventType::leftClick] = (OnLeftClickCB)BIND_FN_1(Slot::onLeftClick);
         m_events[ComponentEventType::mouseHover] = (VoidCB)BIND_FN(Slot::onMouseHover);
-        m_state = DigitalState::low;
+        m_pinCommand = Simulator::Engine::push([uid, type](Netlist &netlist) { netlist.addPin(uid, type); });
     }
 
     void Slot::update(const glm::vec3 &pos, const std::string &label) {
-        m_transform.setPosition(pos);
+        transform().setPosition(pos);
         setLabel(label);
     }
 
     void Slot::update(const glm::vec3 &pos, const glm::vec2 &labelOffset) {
-        m_transform.setPosition(pos);
+        transform().setPosition(pos);
         m_labelOffset = labelOffset;
     }
 
     void Slot::update(const glm::vec3 &pos, const glm::vec2 &labelOffset, const std::string &label) {
-        m_transform.setPosition(pos);
+        transform().setPosition(pos);
         m_labelOffset = labelOffset;
         setLabel(label);
     }
 
     void Slot::update(const glm::vec3 &pos) {
 
-        m_transform.setPosition(pos);
+        transform().setPosition(pos);
     }
 
     void Slot::render() {
-        if (m_isHovered) {
+        if (isHovered()) {
             UI::setCursorPointer();
         }
 
-        float r = 4.0f;
-        auto pos = m_transform.getPosition();
-        auto isHigh = m_state == DigitalState::high;
+        float r = m_width > 1 ? 5.5f : 4.0f;
+        auto pos = transform().getPosition();
+        auto isHigh = getState() == DigitalState::high;
 
         Renderer2D::Renderer::circle(pos, m_highlightBorder ? r + 2.0f : r + 1.f,
                                      m_highlightBorder
@@ -74,23 +74,8 @@ namespace Bess::Simulator::Components {
     }
 
     void Slot::deleteComponent() {
-        m_deleting = true;
-
-        uuids::uuid iId, oId;
-        if (m_type == ComponentType::inputSlot)
-            iId = m_uid;
-        else
-            oId = m_uid;
-
-        for (const auto &connSlot : m_connections) {
-            if (m_type == ComponentType::inputSlot)
-                oId = connSlot;
-            else
-                iId = connSlot;
-
-            auto &connId = ComponentsManager::getConnectionBetween(iId, oId);
+        for (const auto &connId : ComponentsManager::getSlotConnections(m_uid))
             ComponentsManager::deleteComponent(connId);
-        }
     }
 
     void Slot::onLeftClick(const glm::vec2 &pos) {
@@ -121,66 +106,41 @@ namespace Bess::Simulator::Components {
 
     void Slot::onMouseHover() { UI::setCursorPointer(); }
 
-    void Slot::onChange() {
-        if (m_type == ComponentType::outputSlot) {
-            for (auto &slot : m_connections) {
-                Simulator::Engine::addToSimQueue(slot, m_uid, m_state);
-            }
-        } else {
-            Simulator::Engine::addToSimQueue(m_parentUid, m_uid, m_state);
-        }
-    }
-
-    void Slot::addConnection(const uuids::uuid &uid, bool simulate) {
-        if (isConnectedTo(uid))
-            return;
-        m_connections.emplace_back(uid);
-        if (!simulate || m_type == ComponentType::inputSlot)
-            return;
-        Simulator::Engine::addToSimQueue(uid, m_uid, m_state);
-    }
-
     bool Slot::isConnectedTo(const uuids::uuid &uId) {
-        for (auto &conn : m_connections) {
-            if (conn == uId)
-                return true;
-        }
-        return false;
+        return ComponentsManager::areSlotsConnected(m_uid, uId);
     }
 
     void Slot::highlightBorder(bool highlight) { m_highlightBorder = highlight; }
 
     Simulator::DigitalState Slot::getState() const {
-        return m_state;
+        int pin = getPinId();
+        if (pin == Netlist::invalidId)
+            return DigitalState::low;
+        return Simulator::Engine::getPinState(pin);
     }
 
-    void Slot::setState(const uuids::uuid &uid, Simulator::DigitalState state, bool forceUpdate) {
-        if (m_type == ComponentType::inputSlot) {
-            m_stateChangeHistory[uid] = state == DigitalState::high;
-            if (state == DigitalState::low) {
-                for (auto &ent : m_stateChangeHistory) {
-                    if (!ent.second)
-                        continue;
-                    state = DigitalState::high;
-                    break;
-                }
-            }
-        }
+    DigitalState Slot::flipState() {
+        auto state = !getState();
+        int pin = getPinId();
+        if (pin == Netlist::invalidId)
+            Simulator::Engine::drivePin(m_uid, state);
+        else
+            Simulator::Engine::drivePin(pin, state);
+        return state;
+    }
 
-        if (m_state == state && !forceUpdate)
-            return;
-        m_state = state;
-        onChange();
+    int Slot::getPinId() const {
+        if (m_pinId == Netlist::invalidId)
+            m_pinId = Simulator::Engine::getPinId(m_uid, m_pinCommand);
+        return m_pinId;
     }
 
-    DigitalState Slot::flipState() {
-        if (DigitalState::high == m_state) {
-            m_state = DigitalState::low;
-        } else {
-            m_state = DigitalState::high;
-        }
-        onChange();
-        return m_state;
+    int Slot::getWidth() const {
+        return m_width;
+    }
+
+    void Slot::setWidth(int width) {
+        m_width = width;
     }
 
     const uuids::uuid &Slot::getParentId() {
@@ -194,7 +154,7 @@ namespace Bess::Simulator::Components {
         nlohmann::json data;
         data["uid"] = Common::Helpers::uuidToStr(m_uid);
         data["type"] = (int)m_type;
-        for (auto &cid : m_connections)
+        for (auto &cid : getConnections())
             data["connections"].emplace_back(Common::Helpers::uuidToStr(cid));
         return data;
     }
@@ -209,14 +169,11 @@ namespace Bess::Simulator::Components {
         ComponentsManager::components[slotId] = std::make_shared<Components::Slot>(slotId, parentuid, renderId, type);
         ComponentsManager::addRenderIdToCId(renderId, slotId);
         ComponentsManager::addCompIdToRId(renderId, slotId);
-        auto slot = (Slot *)ComponentsManager::components[slotId].get();
-        if (data.contains("connections")) {
+        // both slots list the connection, the output slot creates it
+        if (data.contains("connections") && type == ComponentType::outputSlot) {
             for (auto &cid : data["connections"]) {
                 uuids::uuid connId = Common::Helpers::strToUUID(cid);
-                slot->addConnection(connId, false);
-                if (type == ComponentType::outputSlot) {
-                    Connection::generate(connId, slotId);
-                }
+                Connection::generate(connId, slotId);
             }
         }
 
@@ -238,29 +195,7 @@ namespace Bess::Simulator::Components {
         m_labelOffset = offset;
     }
 
-    const std::vector<uuids::uuid> &Slot::getConnections() {
-        return m_connections;
-    }
-
-    void Slot::simulate(const uuids::uuid &uid, DigitalState state) {
-        setState(uid, state);
-    }
-
-    void Slot::refresh(const uuids::uuid &uid, DigitalState state) {
-        setState(uid, state, true);
-    }
-
-    void Slot::removeConnection(const uuids::uuid &uid) {
-        if (m_deleting)
-            return;
-        int i = 0;
-        while (i < m_connections.size() && m_connections[i] != uid)
-            i++;
-        if (i == m_connections.size())
-            return;
-        m_connections.erase(m_connections.begin() + i);
-        if (m_type == ComponentType::inputSlot && m_stateChangeHistory.find(uid) != m_stateChangeHistory.end())
-            m_stateChangeHistory.erase(uid);
-        setState(uid, DigitalState::low);
+    std::vector<uuids::uuid> Slot::getConnections() {
+        return ComponentsManager::getConnectedSlots(m_uid);
     }
 } // namespace Bess::Simulator::Components
@@ -0,0 +1,184 @@
+#include "components/splitter.h"
+#include "common/helpers.h"
+#include "components/slot.h"
+#include "components_manager/components_manager.h"
+#include "imgui.h"
+#include "pages/main_page/main_page_state.h"
+#include "scene/renderer/renderer.h"
+#include "settings/viewport_theme.h"
+#include "simulator/simulator_engine.h"
+
+namespace Bess::Simulator::Components {
+    Splitter::Splitter(const uuids::uuid &uid, int renderId, glm::vec3 position, ComponentType type,
+                       const uuids::uuid &busSlot, const std::vector<uuids::uuid> &bitSlots)
+        : Component(uid, renderId, position, type), m_busSlot(busSlot), m_bitSlots(bitSlots) {
+        m_name = type == ComponentType::splitter ? splitterName : mergerName;
+        m_events[ComponentEventType::leftClick] = (OnLeftClickCB)[this](auto) {
+            Pages::MainPageState::getInstance()->setBulkId(m_uid);
+        };
+        transform().setScale({80.f, 100.f});
+
+        ComponentsManager::getComponent<Slot>(m_busSlot)->setWidth(static_cast<int>(m_bitSlots.size()));
+
+        Simulator::Engine::push([uid, type, bus = m_busSlot, bits = m_bitSlots](Netlist &netlist) {
+            if (type == ComponentType::splitter)
+                netlist.addNode(uid, NodeKind::splitter, {bus}, bits);
+            else
+                netlist.addNode(uid, NodeKind::merger, bits, {bus});
+        });
+    }
+
+    std::string Splitter::getBankName(ComponentType type, int width) {
+        return std::to_string(width) + "-bit " + (type == ComponentType::splitter ? splitterName : mergerName);
+    }
+
+    int Splitter::widthFromBankName(const std::string &name) {
+        return std::stoi(name);
+    }
+
+    void Splitter::drawBackground(const glm::vec4 &borderThicknessPx, float rPx, float headerHeight, const glm::vec2 &gateSize) {
+        auto borderColor = isSelected() ? ViewportTheme::selectedCompColor : ViewportTheme::componentBorderColor;
+        auto pos = transform().getPosition();
+
+        Renderer2D::Renderer::quad(
+            {pos.x, pos.y + headerHeight / 2.f, pos.z},
+            {gateSize.x, gateSize.y - headerHeight},
+            ViewportTheme::componentBGColor,
+            m_renderId,
+            glm::vec4(0.f, 0.f, rPx, rPx),
+            true,
+            borderColor,
+            glm::vec4(0.f, borderThicknessPx.y, borderThicknessPx.z, borderThicknessPx.w));
+
+        auto headerPos = pos;
+        headerPos.y = pos.y - ((gateSize.y / 2) - (headerHeight / 2.f));
+
+        Renderer2D::Renderer::quad(
+            headerPos,
+            {gateSize.x, headerHeight},
+            ViewportTheme::compHeaderColor,
+            m_renderId,
+            glm::vec4(rPx, rPx, 0.f, 0.f),
+            true,
+            borderColor,
+            glm::vec4(borderThicknessPx.x, borderThicknessPx.y, 0.f, borderThicknessPx.w));
+    }
+
+    void Splitter::render() {
+        float rPx = 16.f;
+
+        glm::vec4 borderThicknessPx({1.f, 1.f, 1.f, 1.f});
+        float headerHeight = 20.f;
+        glm::vec2 slotRowPadding = {4.0f, 4.f};
+        glm::vec2 gatePadding = {4.0f, 4.f};
+        float labelGap = 8.f;
+        float rowGap = 4.f;
+        auto sampleCharSize = Renderer2D::Renderer::getCharRenderSize('Z', 12.f);
+        float sCharHeight = sampleCharSize.y;
+        float rowHeight = (slotRowPadding.y * 2) + sCharHeight;
+
+        auto gateSize_ = transform().getScale();
+        gateSize_.y = headerHeight + (rowHeight + rowGap) * m_bitSlots.size() + 4.f;
+
+        drawBackground(borderThicknessPx, rPx, headerHeight, gateSize_);
+
+        auto leftCornerPos = Common::Helpers::GetLeftCornerPos(transform().getPosition(), gateSize_);
+        const float inputX = leftCornerPos.x + 8.f + gatePadding.x;
+        const float outputX = leftCornerPos.x + gateSize_.x - 8.f - gatePadding.x;
+
+        // the bus slot sits in the middle of its side, the bits are stacked on the other
+        const bool splitter = m_type == ComponentType::splitter;
+        glm::vec3 rowPos = {splitter ? outputX : inputX, leftCornerPos.y + headerHeight + 4.f, leftCornerPos.z};
+        glm::vec2 bitLabelOffset = {splitter ? -labelGap : labelGap, 0.f};
+
+        for (int i = 0; i < m_bitSlots.size(); i++) {
+            auto pos = rowPos;
+            pos.y += rowHeight / 2.f;
+            pos.z += ComponentsManager::zIncrement / 10;
+
+            auto slot = ComponentsManager::getComponent<Slot>(m_bitSlots[i]);
+            slot->update(pos, bitLabelOffset, std::to_string(i));
+            slot->render();
+
+            rowPos.y += rowHeight + rowGap;
+        }
+
+        glm::vec3 busPos = {splitter ? inputX : outputX, leftCornerPos.y + headerHeight + (gateSize_.y - headerHeight) / 2.f, leftCornerPos.z};
+        busPos.z += ComponentsManager::zIncrement / 10;
+        auto busSlot = ComponentsManager::getComponent<Slot>(m_busSlot);
+        busSlot->update(busPos);
+        busSlot->render();
+
+        Renderer2D::Renderer::text(m_name, leftCornerPos + glm::vec3({8.f, 8.f + (sCharHeight / 2.f), ComponentsManager::zIncrement}), 11.f, ViewportTheme::textColor, m_renderId);
+    }
+
+    void Splitter::generate(const glm::vec3 &pos) {
+        generate(ComponentType::splitter, 8, pos);
+    }
+
+    void Splitter::generate(ComponentType type, int width, const glm::vec3 &pos) {
+        auto pId = Common::Helpers::uuidGenerator.getUUID();
+
+        auto addSlot = [&](ComponentType slotType) {
+            auto uid = Common::Helpers::uuidGenerator.getUUID();
+            auto renderId = ComponentsManager::getNextRenderId();
+            ComponentsManager::components[uid] = std::make_shared<Components::Slot>(uid, pId, renderId, slotType);
+            ComponentsManager::addRenderIdToCId(renderId, uid);
+            ComponentsManager::addCompIdToRId(renderId, uid);
+            return uid;
+        };
+
+        const bool splitter = type == ComponentType::splitter;
+        auto busSlot = addSlot(splitter ? ComponentType::inputSlot : ComponentType::outputSlot);
+        std::vector<uuids::uuid> bitSlots;
+        for (int i = 0; i < width; i++)
+            bitSlots.emplace_back(addSlot(splitter ? ComponentType::outputSlot : ComponentType::inputSlot));
+
+        auto renderId = ComponentsManager::getNextRenderId();
+        auto pos_ = pos;
+        pos_.z = ComponentsManager::getNextZPos();
+
+        ComponentsManager::components[pId] = std::make_shared<Splitter>(pId, renderId, pos_, type, busSlot, bitSlots);
+        ComponentsManager::addRenderIdToCId(renderId, pId);
+        ComponentsManager::addCompIdToRId(renderId, pId);
+        ComponentsManager::renderComponents.emplace_back(pId);
+    }
+
+    void Splitter::deleteComponent() {
+        ComponentsManager::deleteComponent(m_busSlot);
+        for (auto &slot : m_bitSlots)
+            ComponentsManager::deleteComponent(slot);
+    }
+
+    void Splitter::drawProperties() {
+        ImGui::Text("%d-bit %s", static_cast<int>(m_bitSlots.size()), m_name.c_str());
+    }
+
+    void Splitter::fromJson(const nlohmann::json &data) {
+        auto uid = Common::Helpers::strToUUID(static_cast<std::string>(data["uid"]));
+        auto type = Common::Helpers::intToCompType(data["type"]);
+        auto pos = Common::Helpers::DecodeVec3(data["pos"]);
+
+        auto busSlot = Slot::fromJson(data["busSlot"], uid);
+        std::vector<uuids::uuid> bitSlots;
+        for (auto &slotJson : data["bitSlots"])
+            bitSlots.emplace_back(Slot::fromJson(slotJson, uid));
+
+        auto renderId = ComponentsManager::getNextRenderId();
+        ComponentsManager::components[uid] = std::make_shared<Splitter>(uid, renderId, pos, type, busSlot, bitSlots);
+        ComponentsManager::addRenderIdToCId(renderId, uid);
+        ComponentsManager::addCompIdToRId(renderId, uid);
+        ComponentsManager::renderComponents.emplace_back(uid);
+    }
+
+    nlohmann::json Splitter::toJson() {
+        nlohmann::json data;
+        data["uid"] = Common::Helpers::uuidToStr(m_uid);
+        data["type"] = (int)m_type;
+        data["pos"] = Common::Helpers::EncodeVec3(transform().getPosition());
+        data["busSlot"] = ComponentsManager::getComponent<Slot>(m_busSlot)->toJson();
+        for (auto &uid : m_bitSlots)
+            data["bitSlots"].emplace_back(ComponentsManager::getComponent<Slot>(uid)->toJson());
+        return data;
+    }
+} // namespace Bess::Simulator::Components
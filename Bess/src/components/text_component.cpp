@@ -35,11 +35,11 @@ namespace Bess::Simulator::Components {
         float width = Common::Helpers::calculateTextWidth(m_text, m_fontSize);
         float height = Common::Helpers::getAnyCharHeight(m_fontSize);
 
-        auto pos = m_transform.getPosition();
+        auto pos = transform().getPosition();
         pos.x += width / 2.f;
         pos.y -= height / 2.f;
 
-        if (m_isSelected) {
+        if (isSelected()) {
             pos.y += 4.f;
             height += 8.f;
             width += 12.f;
@@ -47,10 +47,10 @@ namespace Bess::Simulator::Components {
 
         pos.z -= ComponentsManager::zIncrement;
         auto bgColor = ViewportTheme::backgroundColor;
-        bgColor.w = static_cast<float>(m_isSelected);
-        Renderer2D::Renderer::quad(pos, {width, height}, bgColor, m_renderId, glm::vec4(8.f), ViewportTheme::componentBorderColor, glm::vec4(m_isSelected ? 1.f : 0.f));
+        bgColor.w = static_cast<float>(isSelected());
+        Renderer2D::Renderer::quad(pos, {width, height}, bgColor, m_renderId, glm::vec4(8.f), ViewportTheme::componentBorderColor, glm::vec4(isSelected() ? 1.f : 0.f));
 
-        Renderer2D::Renderer::text(m_text, m_transform.getPosition(), m_fontSize, m_color, m_renderId);
+        Renderer2D::Renderer::text(m_text, transform().getPosition(), m_fontSize, m_color, m_renderId);
     }
 
     void TextComponent::drawProperties() {
@@ -110,7 +110,7 @@ namespace Bess::Simulator::Components {
         j["text"] = m_text;
         j["fontSize"] = m_fontSize;
         j["color"] = Common::Helpers::EncodeVec4(m_color);
-        j["pos"] = Common::Helpers::EncodeVec3(m_transform.getPosition());
+        j["pos"] = Common::Helpers::EncodeVec3(transform().getPosition());
         return j;
     }
 
@@ -0,0 +1,394 @@
+#include "components_manager/command_journal.h"
+#include "common/helpers.h"
+#include "components/connection.h"
+#include "components/connection_point.h"
+#include "components_manager/components_manager.h"
+#include "pages/main_page/main_page_state.h"
+
+#include <algorithm>
+
+namespace Bess::Simulator {
+
+    std::deque<CommandJournal::Command> CommandJournal::m_undo;
+
+    std::vector<CommandJournal::Command> CommandJournal::m_redo;
+
+    CommandJournal::Command CommandJournal::m_group;
+
+    int CommandJournal::m_groupDepth = 0;
+
+    bool CommandJournal::m_replaying = false;
+
+    size_t CommandJournal::m_budget = CommandJournal::defaultBudget;
+
+    size_t CommandJournal::m_usedBytes = 0;
+
+    std::chrono::steady_clock::time_point CommandJournal::m_lastChange;
+
+    static bool exists(const uuids::uuid &uid) {
+        const auto it = ComponentsManager::components.find(uid);
+        return it != ComponentsManager::components.end() && it->second != nullptr;
+    }
+
+    void CommandJournal::recordAdd(const uuids::uuid &uid) {
+        if (uid.is_nil())
+            return;
+        record({OperationType::add, uid});
+    }
+
+    void CommandJournal::recordRemove(const uuids::uuid &uid) {
+        if (m_replaying)
+            return;
+        Operation operation{OperationType::remove, uid};
+        operation.snapshot = capture(uid);
+        const auto &snapshot = operation.snapshot;
+        if (snapshot.components.empty() && snapshot.wires.empty() && snapshot.points.empty())
+            return;
+        record(std::move(operation));
+    }
+
+    void CommandJournal::recordMove(const uuids::uuid &uid, const glm::vec3 &from, const glm::vec3 &to) {
+        if (m_replaying || from == to)
+            return;
+        if (m_groupDepth > 0) {
+            for (auto &operation : m_group.operations) {
+                if (operation.type == OperationType::move && operation.uid == uid) {
+                    operation.to = to;
+                    return;
+                }
+            }
+        }
+        Operation operation{OperationType::move, uid};
+        operation.from = from;
+        operation.to = to;
+        record(std::move(operation));
+    }
+
+    void CommandJournal::recordChange(const nlohmann::json &before, const nlohmann::json &after) {
+        if (m_replaying || before == after)
+            return;
+        Operation operation{OperationType::change, Common::Helpers::strToUUID(before["uid"].get<std::string>())};
+        operation.before = before;
+        operation.after = after;
+        stripConnections(operation.before);
+        stripConnections(operation.after);
+        recordChange(std::move(operation));
+    }
+
+    void CommandJournal::recordChange(Operation &&operation) {
+        // merged once the group ends, if it is the only edit in it
+        if (m_groupDepth > 0) {
+            record(std::move(operation));
+            return;
+        }
+
+        // typing into a field edits the component on every key
+        const auto now = std::chrono::steady_clock::now();
+        if (!m_undo.empty() && now - m_lastChange < coalesceWindow) {
+            auto &last = m_undo.back();
+            if (last.operations.size() == 1 && last.operations.front().type == OperationType::change &&
+                last.operations.front().uid == operation.uid) {
+                last.operations.front().after = std::move(operation.after);
+                m_usedBytes -= last.bytes;
+                measure(last);
+                m_usedBytes += last.bytes;
+                m_lastChange = now;
+                return;
+            }
+        }
+        m_lastChange = now;
+        record(std::move(operation));
+    }
+
+    void CommandJournal::beginGroup() {
+        m_groupDepth++;
+    }
+
+    void CommandJournal::endGroup() {
+        if (m_groupDepth == 0 || --m_groupDepth > 0)
+            return;
+        // a component dragged back to where it started
+        std::erase_if(m_group.operations, [](const Operation &operation) {
+            return operation.type == OperationType::move && operation.from == operation.to;
+        });
+        // a group holding a single property edit still merges with the edits before it
+        if (m_group.operations.size() == 1 && m_group.operations.front().type == OperationType::change) {
+            auto operation = std::move(m_group.operations.front());
+            m_group = {};
+            recordChange(std::move(operation));
+            return;
+        }
+        if (!m_group.operations.empty())
+            push(std::move(m_group));
+        m_group = {};
+    }
+
+    bool CommandJournal::undo() {
+        if (m_undo.empty() || m_groupDepth > 0)
+            return false;
+        auto command = std::move(m_undo.back());
+        m_undo.pop_back();
+        m_usedBytes -= command.bytes;
+
+        m_replaying = true;
+        for (auto it = command.operations.rbegin(); it != command.operations.rend(); it++)
+            undo(*it);
+        m_replaying = false;
+
+        measure(command);
+        m_usedBytes += command.bytes;
+        m_redo.emplace_back(std::move(command));
+        m_lastChange = {};
+        // the hovered component may be gone
+        Pages::MainPageState::getInstance()->setHoveredId(-1);
+        return true;
+    }
+
+    bool CommandJournal::redo() {
+        if (m_redo.empty() || m_groupDepth > 0)
+            return false;
+        auto command = std::move(m_redo.back());
+        m_redo.pop_back();
+        m_usedBytes -= command.bytes;
+
+        m_replaying = true;
+        for (auto &operation : command.operations)
+            redo(operation);
+        m_replaying = false;
+
+        measure(command);
+        m_usedBytes += command.bytes;
+        m_undo.emplace_back(std::move(command));
+        m_lastChange = {};
+        Pages::MainPageState::getInstance()->setHoveredId(-1);
+        trim();
+        return true;
+    }
+
+    bool CommandJournal::canUndo() {
+        return !m_undo.empty() && m_groupDepth == 0;
+    }
+
+    bool CommandJournal::canRedo() {
+        return !m_redo.empty() && m_groupDepth == 0;
+    }
+
+    void CommandJournal::clear() {
+        m_undo.clear();
+        m_redo.clear();
+        m_group = {};
+        m_groupDepth = 0;
+        m_usedBytes = 0;
+        m_lastChange = {};
+    }
+
+    void CommandJournal::setMemoryBudget(size_t bytes) {
+        m_budget = bytes;
+        trim();
+    }
+
+    size_t CommandJournal::getMemoryUsage() {
+        return m_usedBytes;
+    }
+
+    void CommandJournal::record(Operation &&operation) {
+        if (m_replaying)
+            return;
+        if (m_groupDepth > 0) {
+            m_group.operations.emplace_back(std::move(operation));
+            return;
+        }
+        Command command;
+        command.operations.emplace_back(std::move(operation));
+        push(std::move(command));
+    }
+
+    void CommandJournal::push(Command &&command) {
+        for (const auto &redoCommand : m_redo)
+            m_usedBytes -= redoCommand.bytes;
+        m_redo.clear();
+
+        measure(command);
+        m_usedBytes += command.bytes;
+        m_undo.emplace_back(std::move(command));
+        trim();
+    }
+
+    void CommandJournal::measure(Command &command) {
+        auto jsonBytes = [](const nlohmann::json &data) -> size_t {
+            return data.is_null() ? 0 : data.dump().size();
+        };
+
+        size_t bytes = sizeof(Command);
+        for (const auto &operation : command.operations) {
+            bytes += sizeof(Operation) + jsonBytes(operation.before) + jsonBytes(operation.after);
+            const auto &snapshot = operation.snapshot;
+            for (const auto &data : snapshot.components)
+                bytes += jsonBytes(data);
+            for (const auto &wire : snapshot.wires) {
+                bytes += sizeof(Snapshot::Wire);
+                for (const auto &point : wire.points)
+                    bytes += jsonBytes(point);
+            }
+            for (const auto &point : snapshot.points)
+                bytes += sizeof(Snapshot::Point) + jsonBytes(point.data);
+        }
+        command.bytes = bytes;
+    }
+
+    void CommandJournal::trim() {
+        // the latest edit stays undoable whatever its size
+        while (m_usedBytes > m_budget && m_undo.size() > 1) {
+            m_usedBytes -= m_undo.front().bytes;
+            m_undo.pop_front();
+        }
+    }
+
+    void CommandJournal::undo(Operation &operation) {
+        switch (operation.type) {
+        case OperationType::add:
+            operation.snapshot = capture(operation.uid);
+            erase(operation.snapshot);
+            break;
+        case OperationType::remove:
+            restore(operation.snapshot);
+            break;
+        case OperationType::move:
+            if (exists(operation.uid))
+                ComponentsManager::components[operation.uid]->setPosition(operation.from);
+            break;
+        case OperationType::change:
+            replace(operation.before);
+            break;
+        }
+    }
+
+    void CommandJournal::redo(Operation &operation) {
+        switch (operation.type) {
+        case OperationType::add:
+            restore(operation.snapshot);
+            operation.snapshot = {};
+            break;
+        case OperationType::remove:
+            operation.snapshot = capture(operation.uid);
+            erase(operation.snapshot);
+            break;
+        case OperationType::move:
+            if (exists(operation.uid))
+                ComponentsManager::components[operation.uid]->setPosition(operation.to);
+            break;
+        case OperationType::change:
+            replace(operation.after);
+            break;
+        }
+    }
+
+    CommandJournal::Snapshot CommandJournal::capture(const uuids::uuid &uid) {
+        Snapshot snapshot;
+        if (!exists(uid))
+            return snapshot;
+
+        switch (ComponentsManager::components[uid]->getType()) {
+        case ComponentType::connection:
+            captureWire(uid, snapshot);
+            break;
+        case ComponentType::connectionPoint: {
+            auto data = ComponentsManager::getComponent<Components::ConnectionPoint>(uid)->toJson();
+            const auto connection = ComponentsManager::getConnectionBetween(data["parentSlots"].get<std::string>());
+            const auto &points = ComponentsManager::getComponent<Components::Connection>(connection)->getPoints();
+            const size_t index = std::ranges::find(points, uid) - points.begin();
+            snapshot.points.push_back({std::move(data), connection, index});
+        } break;
+        default: {
+            auto data = ComponentsManager::componentToJson(uid);
+            if (data.is_null())
+                break;
+            for (const auto &slot : stripConnections(data)) {
+                for (const auto &connection : ComponentsManager::getSlotConnections(slot))
+                    captureWire(connection, snapshot);
+            }
+            snapshot.components.emplace_back(std::move(data));
+        } break;
+        }
+        return snapshot;
+    }
+
+    void CommandJournal::captureWire(const uuids::uuid &connection, Snapshot &snapshot) {
+        if (std::ranges::any_of(snapshot.wires, [&](const Snapshot::Wire &wire) { return wire.uid == connection; }))
+            return;
+
+        Snapshot::Wire wire{connection};
+        std::tie(wire.inputSlot, wire.outputSlot) = ComponentsManager::getConnectionSlots(connection);
+        for (const auto &point : ComponentsManager::getComponent<Components::Connection>(connection)->getPoints())
+            wire.points.emplace_back(ComponentsManager::getComponent<Components::ConnectionPoint>(point)->toJson());
+        snapshot.wires.emplace_back(std::move(wire));
+    }
+
+    void CommandJournal::restore(const Snapshot &snapshot) {
+        for (const auto &data : snapshot.components)
+            ComponentsManager::componentFromJson(data);
+
+        for (const auto &wire : snapshot.wires) {
+            // the component on the other end may have been deleted since
+            if (exists(wire.uid) || !exists(wire.inputSlot) || !exists(wire.outputSlot))
+                continue;
+            Components::Connection::restore(wire.uid, wire.inputSlot, wire.outputSlot);
+            for (const auto &point : wire.points)
+                Components::ConnectionPoint::fromJson(point);
+        }
+
+        for (const auto &point : snapshot.points) {
+            const auto uid = Common::Helpers::strToUUID(point.data["uid"].get<std::string>());
+            if (exists(uid) || !exists(point.connection))
+                continue;
+            Components::ConnectionPoint::fromJson(point.data);
+            // the points of a wire are its path, put it back in its place
+            const auto connection = ComponentsManager::getComponent<Components::Connection>(point.connection);
+            connection->removePoint(uid);
+            connection->insertPoint(uid, point.index);
+        }
+    }
+
+    void CommandJournal::erase(const Snapshot &snapshot) {
+        for (const auto &point : snapshot.points)
+            ComponentsManager::deleteComponent(Common::Helpers::strToUUID(point.data["uid"].get<std::string>()));
+        for (const auto &wire : snapshot.wires)
+            ComponentsManager::deleteComponent(wire.uid);
+        for (const auto &data : snapshot.components)
+            ComponentsManager::deleteComponent(Common::Helpers::strToUUID(data["uid"].get<std::string>()));
+    }
+
+    void CommandJournal::replace(const nlohmann::json &data) {
+        const auto uid = Common::Helpers::strToUUID(data["uid"].get<std::string>());
+        if (!exists(uid))
+            return;
+
+        const auto state = Pages::MainPageState::getInstance();
+        const bool selected = state->isBulkIdPresent(uid);
+
+        auto wires = capture(uid);
+        wires.components.clear();
+        ComponentsManager::deleteComponent(uid);
+        ComponentsManager::componentFromJson(data);
+        restore(wires);
+
+        if (selected)
+            state->addBulkId(uid);
+    }
+
+    std::vector<uuids::uuid> CommandJournal::stripConnections(nlohmann::json &data) {
+        std::vector<uuids::uuid> slots;
+        auto visit = [&slots](auto &self, nlohmann::json &node) -> void {
+            if (node.is_object() && node.contains("connections") && node.contains("uid")) {
+                slots.emplace_back(Common::Helpers::strToUUID(node["uid"].get<std::string>()));
+                node.erase("connections");
+            }
+            if (node.is_structured()) {
+                for (auto &child : node)
+                    self(self, child);
+            }
+        };
+        visit(visit, data);
+        return slots;
+    }
+} // namespace Bess::Simulator
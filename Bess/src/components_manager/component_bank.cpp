@@ -1,9 +1,17 @@
 #include "components_manager/component_bank.h"
 
+#include <algorithm>
+#include <cctype>
 #include <fstream>
+#include <functional>
+#include <iomanip>
+#include <set>
+#include <stdexcept>
 
 namespace Bess::Simulator{
     ComponentBank::BankVault ComponentBank::m_vault{};
+    std::unordered_map<std::string, std::string> ComponentBank::m_collectionFiles{};
+    std::string ComponentBank::m_collectionsListPath = "";
 
     void Simulator::ComponentBank::addToCollection(std::string collectionName, ComponentBankElement element)
     {
@@ -32,6 +40,7 @@ namespace Bess::Simulator{
         std::ifstream file(filepath);
         nlohmann::json data = nlohmann::json::parse(file);
         std::string collectionName = data["collectionName"];
+        m_collectionFiles[collectionName] = filepath;
         for (auto& cjson : data["components"]) {
             Components::JComponentData compData(cjson,collectionName);
             ComponentBankElement el(ComponentType::jcomponent, compData.getName(), compData);
@@ -47,6 +56,7 @@ namespace Bess::Simulator{
         file.close();
 
         std::vector<std::string> collectionPaths = data["collections"];
+        m_collectionsListPath = filepath;
 
         std::string basePath = filepath.substr(0, filepath.find_last_of("/"));
 
@@ -57,6 +67,78 @@ namespace Bess::Simulator{
         }
     }
     
+    void ComponentBank::saveToCollection(const std::string& collection, const nlohmann::json& entry)
+    {
+        Components::JComponentData compData(entry, collection);
+        if (getJCompData(collection, compData.getName()) != nullptr)
+            throw std::runtime_error(collection + " already has a component named " + compData.getName());
+
+        auto it = m_collectionFiles.find(collection);
+        if (it == m_collectionFiles.end()) {
+            if (m_collectionsListPath.empty())
+                throw std::runtime_error("No collections list is loaded to add " + collection + " to");
+
+            std::string fileName = collection;
+            std::transform(fileName.begin(), fileName.end(), fileName.begin(), [](unsigned char ch) {
+                return std::isalnum(ch) ? (char)std::tolower(ch) : '_';
+            });
+            fileName += ".json";
+
+            std::ifstream listFile(m_collectionsListPath);
+            nlohmann::json list = nlohmann::json::parse(listFile);
+            listFile.close();
+            list["collections"].emplace_back("./" + fileName);
+            std::ofstream(m_collectionsListPath) << std::setw(2) << list << std::endl;
+
+            nlohmann::json collectionJson;
+            collectionJson["collectionName"] = collection;
+            collectionJson["components"] = nlohmann::json::array();
+            auto path = m_collectionsListPath.substr(0, m_collectionsListPath.find_last_of("/")) + "/" + fileName;
+            std::ofstream(path) << std::setw(2) << collectionJson << std::endl;
+            it = m_collectionFiles.emplace(collection, path).first;
+        }
+
+        std::ifstream file(it->second);
+        nlohmann::json data = nlohmann::json::parse(file);
+        file.close();
+        data["components"].emplace_back(entry);
+        std::ofstream(it->second) << std::setw(2) << data << std::endl;
+
+        m_vault[collection].emplace_back(ComponentType::jcomponent, compData.getName(), compData);
+    }
+
+    nlohmann::json ComponentBank::getSubcircuitEntries(const std::vector<std::shared_ptr<Components::JComponentData>>& used)
+    {
+        nlohmann::json entries = nlohmann::json::array();
+        std::set<const Components::JComponentData*> added;
+
+        std::function<void(const Components::JComponentData*)> add = [&](const Components::JComponentData* data) {
+            if (!data->isSubcircuit() || !added.insert(data).second)
+                return;
+            for (auto& gate : data->getSubcircuit()->getGates())
+                add(gate.data.get());
+
+            auto entry = data->toJson();
+            entry["collection"] = data->getCollectionName();
+            entries.emplace_back(entry);
+        };
+
+        for (auto& data : used)
+            add(data.get());
+        return entries;
+    }
+
+    void ComponentBank::loadSubcircuitEntries(const nlohmann::json& entries)
+    {
+        for (auto& entry : entries) {
+            std::string collection = entry["collection"];
+            if (getJCompData(collection, entry["name"]) != nullptr)
+                continue;
+            Components::JComponentData compData(entry, collection);
+            m_vault[collection].emplace_back(ComponentType::jcomponent, compData.getName(), compData);
+        }
+    }
+
     Simulator::ComponentBankElement::ComponentBankElement(ComponentType type, const std::string& name): m_type(type), m_name(name)
     {
 
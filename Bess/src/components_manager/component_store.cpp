@@ -0,0 +1,148 @@
+#include "components_manager/component_store.h"
+#include "components/component.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Bess::Simulator {
+
+    size_t ComponentStore::Archetype::size() const {
+        return objects.size();
+    }
+
+    ComponentStore::Storage &ComponentStore::storage() {
+        // never destroyed, components held by other statics unregister
+        // themselves during exit
+        static auto *instance = new Storage();
+        return *instance;
+    }
+
+    size_t ComponentStore::indexOf(ComponentType type) {
+        const int value = static_cast<int>(type);
+        if (value < static_cast<int>(ComponentType::jcomponent))
+            return value + 1;
+        return value - static_cast<int>(ComponentType::jcomponent) + static_cast<int>(ComponentType::button) + 2;
+    }
+
+    ComponentStore::Slot &ComponentStore::getSlot(ComponentHandle handle) {
+        assert(isValid(handle));
+        return storage().slots[handle.slot];
+    }
+
+    ComponentHandle ComponentStore::add(Components::Component *object, ComponentType type) {
+        auto &store = storage();
+        auto &archetype = store.archetypes[indexOf(type)];
+
+        uint32_t slotIndex;
+        if (store.freeSlots.empty()) {
+            slotIndex = store.slots.size();
+            store.slots.emplace_back();
+        } else {
+            slotIndex = store.freeSlots.back();
+            store.freeSlots.pop_back();
+        }
+
+        auto &slot = store.slots[slotIndex];
+        slot.type = type;
+        slot.index = archetype.size();
+        slot.alive = true;
+
+        archetype.objects.emplace_back(object);
+        archetype.transforms.emplace_back();
+        archetype.flags.emplace_back(0);
+        archetype.slots.emplace_back(slotIndex);
+
+        object->m_archetype = &archetype;
+        object->m_storeIndex = slot.index;
+
+        return {slotIndex, slot.generation};
+    }
+
+    void ComponentStore::remove(ComponentHandle handle) {
+        auto &store = storage();
+        auto &slot = getSlot(handle);
+        auto &archetype = store.archetypes[indexOf(slot.type)];
+
+        // move the last entry into the hole
+        const uint32_t last = archetype.size() - 1;
+        if (slot.index != last) {
+            archetype.objects[slot.index] = archetype.objects[last];
+            archetype.transforms[slot.index] = archetype.transforms[last];
+            archetype.flags[slot.index] = archetype.flags[last];
+            archetype.slots[slot.index] = archetype.slots[last];
+            store.slots[archetype.slots[last]].index = slot.index;
+            archetype.objects[slot.index]->m_storeIndex = slot.index;
+        }
+        archetype.objects.pop_back();
+        archetype.transforms.pop_back();
+        archetype.flags.pop_back();
+        archetype.slots.pop_back();
+
+        slot.alive = false;
+        slot.generation++;
+        store.freeSlots.emplace_back(handle.slot);
+    }
+
+    bool ComponentStore::isValid(ComponentHandle handle) {
+        const auto &slots = storage().slots;
+        return handle.slot < slots.size() && slots[handle.slot].alive && slots[handle.slot].generation == handle.generation;
+    }
+
+    Scene::Transform::Transform2D &ComponentStore::getTransform(ComponentHandle handle) {
+        const auto &slot = getSlot(handle);
+        return storage().archetypes[indexOf(slot.type)].transforms[slot.index];
+    }
+
+    bool ComponentStore::hasFlag(ComponentHandle handle, uint8_t flag) {
+        const auto &slot = getSlot(handle);
+        return storage().archetypes[indexOf(slot.type)].flags[slot.index] & flag;
+    }
+
+    void ComponentStore::setFlag(ComponentHandle handle, uint8_t flag, bool value) {
+        const auto &slot = getSlot(handle);
+        auto &flags = storage().archetypes[indexOf(slot.type)].flags[slot.index];
+        flags = value ? flags | flag : flags & ~flag;
+    }
+
+    ComponentStore::Archetype &ComponentStore::getArchetype(ComponentType type) {
+        return storage().archetypes[indexOf(type)];
+    }
+
+    const std::vector<ComponentType> &ComponentStore::getTypes() {
+        static const std::vector<ComponentType> types = {
+            ComponentType::inputSlot,
+            ComponentType::outputSlot,
+            ComponentType::connection,
+            ComponentType::button,
+            ComponentType::jcomponent,
+            ComponentType::inputProbe,
+            ComponentType::outputProbe,
+            ComponentType::text,
+            ComponentType::connectionPoint,
+            ComponentType::clock,
+            ComponentType::flipFlop,
+            ComponentType::splitter,
+            ComponentType::merger,
+        };
+        return types;
+    }
+
+    const std::vector<ComponentType> &ComponentStore::getRenderTypes() {
+        static const std::vector<ComponentType> types = {
+            ComponentType::connection,
+            ComponentType::jcomponent,
+            ComponentType::flipFlop,
+            ComponentType::splitter,
+            ComponentType::merger,
+            ComponentType::clock,
+            ComponentType::inputProbe,
+            ComponentType::outputProbe,
+            ComponentType::text,
+        };
+        return types;
+    }
+
+    bool ComponentStore::isRenderType(ComponentType type) {
+        return std::ranges::find(getRenderTypes(), type) != getRenderTypes().end();
+    }
+} // namespace Bess::Simulator
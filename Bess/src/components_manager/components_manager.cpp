@@ -1,9 +1,12 @@
 #include "components_manager/components_manager.h"
+#include "components_manager/command_journal.h"
+#include "components_manager/component_store.h"
 
 #include "components/clock.h"
 #include "components/connection.h"
 #include "components/input_probe.h"
 #include "components/jcomponent.h"
+#include "components/splitter.h"
 #include "components/text_component.h"
 
 #include "common/helpers.h"
@@ -11,8 +14,13 @@
 #include "components/output_probe.h"
 #include "components_manager/component_bank.h"
 #include "pages/main_page/main_page_state.h"
+#include "scene/spatial_index.h"
+#include "simulator/simulator_engine.h"
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
+#include <stdexcept>
 
 namespace Bess::Simulator {
 
@@ -20,10 +28,12 @@ namespace Bess::Simulator {
 
     std::unordered_map<uuids::uuid, int> ComponentsManager::m_compIdToRId;
 
-    std::unordered_map<std::string, uuids::uuid> ComponentsManager::m_slotsToConn;
+    ConnectionIndex ComponentsManager::m_connectionIndex;
 
     int ComponentsManager::renderIdCounter;
 
+    int ComponentsManager::m_deleteDepth = 0;
+
     std::unordered_map<uuids::uuid, ComponentPtr> ComponentsManager::components;
 
     std::vector<uuids::uuid> ComponentsManager::renderComponents;
@@ -39,7 +49,7 @@ namespace Bess::Simulator {
         reset();
     }
 
-    void ComponentsManager::generateComponent(ComponentType type, const std::any &data, const glm::vec3 &pos) {
+    uuids::uuid ComponentsManager::generateComponent(ComponentType type, const std::any &data, const glm::vec3 &pos) {
         switch (type) {
         case ComponentType::jcomponent: {
             const auto val = std::any_cast<const std::shared_ptr<Components::JComponentData>>(data);
@@ -62,39 +72,178 @@ namespace Bess::Simulator {
                 Components::JKFlipFlop().generate(pos);
             else if (name == Components::DFlipFlop::name)
                 Components::DFlipFlop().generate(pos);
+            else if (name == Components::DRegister::name)
+                Components::DRegister().generate(pos);
+            else if (name == Components::Counter::name)
+                Components::Counter().generate(pos);
+            else if (name == Components::ShiftRegister::name)
+                Components::ShiftRegister().generate(pos);
+            else if (name == Components::RegisterFile::name)
+                Components::RegisterFile().generate(pos);
             // else if (name == Components::SRFlipFlop::name)
             //     Components::SRFlipFlop().generate(pos);
         } break;
+        case ComponentType::splitter:
+        case ComponentType::merger: {
+            const auto name = std::any_cast<std::string>(data);
+            Components::Splitter().generate(type, Components::Splitter::widthFromBankName(name), pos);
+        } break;
         default:
             throw std::runtime_error("Component type not registered in components manager " + std::to_string(static_cast<int>(type)));
         }
+        // every generate function adds the placed component to the render list last
+        const auto &uid = renderComponents.back();
+        CommandJournal::recordAdd(uid);
+        return uid;
     }
 
-    void ComponentsManager::generateComponent(const ComponentBankElement &comp, const glm::vec3 &pos) {
+    uuids::uuid ComponentsManager::generateComponent(const ComponentBankElement &comp, const glm::vec3 &pos) {
         std::any data = NULL;
         if (comp.getType() == Simulator::ComponentType::jcomponent) {
             data = comp.getJCompData();
-        } else if (comp.getType() == Simulator::ComponentType::flipFlop) {
+        } else if (comp.getType() == Simulator::ComponentType::flipFlop || comp.getType() == Simulator::ComponentType::splitter || comp.getType() == Simulator::ComponentType::merger) {
             data = comp.getName();
         }
-        generateComponent(comp.getType(), data, pos);
+        return generateComponent(comp.getType(), data, pos);
+    }
+
+    std::vector<uuids::uuid> ComponentsManager::generateArray(const ComponentBankElement &comp, int rows, int cols,
+                                                              const glm::vec3 &pos, const glm::vec2 &spacing,
+                                                              const std::vector<ArrayLink> &links) {
+        if (rows <= 0 || cols <= 0)
+            throw std::runtime_error("Arrays need at least one row and one column");
+
+        // slots are components of their own
+        size_t perElement = 8;
+        if (const auto data = comp.getJCompData(); data != nullptr)
+            perElement = 1 + data->getInputCount() + data->getOutputs().size();
+        reserve(size_t(rows) * cols * perElement);
+        renderComponents.reserve(renderComponents.size() + size_t(rows) * cols);
+
+        std::vector<uuids::uuid> placed;
+        placed.reserve(size_t(rows) * cols);
+        // the whole array is undone at once
+        CommandJournal::beginGroup();
+        try {
+            for (int row = 0; row < rows; row++) {
+                for (int col = 0; col < cols; col++) {
+                    const glm::vec3 elementPos = {pos.x + col * spacing.x, pos.y + row * spacing.y, pos.z};
+                    placed.emplace_back(generateComponent(comp, elementPos));
+                    if (col == 0)
+                        continue;
+
+                    const auto &prev = placed[placed.size() - 2], &next = placed.back();
+                    for (const auto &link : links)
+                        addConnection(findSlot(prev, link.output, ComponentType::outputSlot), findSlot(next, link.input, ComponentType::inputSlot));
+                }
+            }
+        } catch (...) {
+            CommandJournal::endGroup();
+            throw;
+        }
+        CommandJournal::endGroup();
+        return placed;
+    }
+
+    uuids::uuid ComponentsManager::findSlot(const uuids::uuid &component, const std::string &pin, ComponentType slotType) {
+        const auto &comp = components.at(component);
+        const auto slots = comp->getSlots(slotType);
+        for (int i = 0; i < slots.size(); i++) {
+            if (comp->getSlotLabel(slotType, i) == pin)
+                return slots[i];
+        }
+
+        if (!pin.empty() && std::ranges::all_of(pin, [](char ch) { return std::isdigit(ch); })) {
+            if (const int index = std::stoi(pin); index < slots.size())
+                return slots[index];
+        }
+        throw std::runtime_error(comp->getName() + " has no " + (slotType == ComponentType::inputSlot ? "input " : "output ") + pin);
+    }
+
+    void ComponentsManager::reserve(size_t count) {
+        components.reserve(components.size() + count);
+        m_renderIdToCId.reserve(m_renderIdToCId.size() + count);
+        m_compIdToRId.reserve(m_compIdToRId.size() + count);
     }
 
     void ComponentsManager::deleteComponent(const uuids::uuid uid) {
         if (uid.is_nil() || !components.contains(uid))
             return;
 
+        if (m_deleteDepth == 0)
+            CommandJournal::recordRemove(uid);
+        m_deleteDepth++;
+
         if (const auto renderIt = std::ranges::find(renderComponents, uid); renderIt != renderComponents.end()) {
             renderComponents.erase(renderIt);
         }
         if (const auto state = Pages::MainPageState::getInstance(); state->isBulkIdPresent(uid))
             state->removeBulkId(uid, false);
 
+        Scene::SpatialIndex::remove(m_compIdToRId[uid]);
         m_renderIdToCId.erase(m_compIdToRId[uid]);
         m_compIdToRId.erase(uid);
         components[uid]->deleteComponent();
 
+        if (const auto type = components[uid]->getType(); type == ComponentType::inputSlot || type == ComponentType::outputSlot)
+            Engine::push([uid](Netlist &netlist) { netlist.removePin(uid); });
+        else
+            Engine::push([uid](Netlist &netlist) { netlist.removeNode(uid); });
+
         components.erase(uid);
+        m_deleteDepth--;
+    }
+
+    nlohmann::json ComponentsManager::componentToJson(const uuids::uuid &uid) {
+        const auto &ent = components.at(uid);
+        switch (ent->getType()) {
+        case ComponentType::inputProbe:
+            return ((Components::InputProbe *)ent.get())->toJson();
+        case ComponentType::outputProbe:
+            return ((Components::OutputProbe *)ent.get())->toJson();
+        case ComponentType::jcomponent:
+            return ((Components::JComponent *)ent.get())->toJson();
+        case ComponentType::text:
+            return ((Components::TextComponent *)ent.get())->toJson();
+        case ComponentType::clock:
+            return ((Components::Clock *)ent.get())->toJson();
+        case ComponentType::flipFlop:
+            return ((Components::FlipFlop *)ent.get())->toJson();
+        case ComponentType::splitter:
+        case ComponentType::merger:
+            return ((Components::Splitter *)ent.get())->toJson();
+        default:
+            return nullptr;
+        }
+    }
+
+    void ComponentsManager::componentFromJson(const nlohmann::json &data) {
+        switch (Common::Helpers::intToCompType(data["type"])) {
+        case ComponentType::inputProbe:
+            Components::InputProbe::fromJson(data);
+            break;
+        case ComponentType::outputProbe:
+            Components::OutputProbe::fromJson(data);
+            break;
+        case ComponentType::jcomponent:
+            Components::JComponent::fromJson(data);
+            break;
+        case ComponentType::text:
+            Components::TextComponent::fromJson(data);
+            break;
+        case ComponentType::clock:
+            Components::Clock::fromJson(data);
+            break;
+        case ComponentType::flipFlop:
+            Components::FlipFlop::fromJson(data);
+            break;
+        case ComponentType::splitter:
+        case ComponentType::merger:
+            Components::Splitter::fromJson(data);
+            break;
+        default:
+            break;
+        }
     }
 
     uuids::uuid ComponentsManager::addConnection(const uuids::uuid &start, const uuids::uuid &end) {
@@ -117,11 +266,10 @@ namespace Bess::Simulator {
         if (outputSlot->isConnectedTo(iId))
             return emptyId;
 
-        outputSlot->addConnection(iId);
-        inputSlot->addConnection(oId);
-
         // adding interactive wire
-        return Components::Connection::generate(iId, oId);
+        const auto uid = Components::Connection::generate(iId, oId);
+        CommandJournal::recordAdd(uid);
+        return uid;
     }
 
     const uuids::uuid &ComponentsManager::renderIdToCid(const int rId) {
@@ -149,34 +297,45 @@ namespace Bess::Simulator {
     }
 
     void ComponentsManager::addSlotsToConn(const uuids::uuid &inpSlot, const uuids::uuid &outSlot, const uuids::uuid &conn) {
-        const std::string key = Common::Helpers::uuidToStr(inpSlot) + "," + Common::Helpers::uuidToStr(outSlot);
-        m_slotsToConn[key] = conn;
+        m_connectionIndex.add(inpSlot, outSlot, conn);
     }
 
     const uuids::uuid &ComponentsManager::getConnectionBetween(const uuids::uuid &inpSlot, const uuids::uuid &outSlot) {
-        const std::string key = Common::Helpers::uuidToStr(inpSlot) + "," + Common::Helpers::uuidToStr(outSlot);
-        return m_slotsToConn[key];
+        return m_connectionIndex.getConnection(inpSlot, outSlot);
     }
 
     const uuids::uuid &ComponentsManager::getConnectionBetween(const std::string &inputOutputSlot) {
-        return m_slotsToConn[inputOutputSlot];
+        const auto comma = inputOutputSlot.find(',');
+        if (comma == std::string::npos)
+            throw std::runtime_error("Invalid connection slots " + inputOutputSlot);
+        return getConnectionBetween(Common::Helpers::strToUUID(inputOutputSlot.substr(0, comma)),
+                                    Common::Helpers::strToUUID(inputOutputSlot.substr(comma + 1)));
     }
 
     void ComponentsManager::removeSlotsToConn(const uuids::uuid &inpSlot, const uuids::uuid &outSlot) {
-        const std::string key = Common::Helpers::uuidToStr(inpSlot) + "," + Common::Helpers::uuidToStr(outSlot);
-        if (!m_slotsToConn.contains(key))
-            return;
-        m_slotsToConn.erase(key);
+        if (const auto &conn = m_connectionIndex.getConnection(inpSlot, outSlot); !conn.is_nil())
+            m_connectionIndex.remove(conn);
     }
 
-    const std::string &ComponentsManager::getSlotsForConnection(const uuids::uuid &conn) {
-        // extracts key from m_slotsToConn based on conn id
-        for (auto &[key, value] : m_slotsToConn) {
-            if (value == conn)
-                return key;
-        }
+    std::string ComponentsManager::getSlotsForConnection(const uuids::uuid &conn) {
+        const auto [inpSlot, outSlot] = m_connectionIndex.getSlots(conn);
+        return Common::Helpers::uuidToStr(inpSlot) + "," + Common::Helpers::uuidToStr(outSlot);
+    }
+
+    std::pair<uuids::uuid, uuids::uuid> ComponentsManager::getConnectionSlots(const uuids::uuid &conn) {
+        return m_connectionIndex.getSlots(conn);
+    }
+
+    std::vector<uuids::uuid> ComponentsManager::getSlotConnections(const uuids::uuid &slot) {
+        return m_connectionIndex.getConnections(slot);
+    }
+
+    std::vector<uuids::uuid> ComponentsManager::getConnectedSlots(const uuids::uuid &slot) {
+        return m_connectionIndex.getConnectedSlots(slot);
+    }
 
-        throw std::runtime_error("Abandoned Connection");
+    bool ComponentsManager::areSlotsConnected(const uuids::uuid &slotA, const uuids::uuid &slotB) {
+        return m_connectionIndex.isConnected(slotA, slotB);
     }
 
     int ComponentsManager::getNextRenderId() { return renderIdCounter++; }
@@ -188,8 +347,13 @@ namespace Bess::Simulator {
         renderComponents.clear();
         m_compIdToRId.clear();
         m_renderIdToCId.clear();
+        m_connectionIndex.clear();
+        Scene::SpatialIndex::clear();
+        CommandJournal::clear();
         m_compIdToRId[emptyId] = -1;
         m_renderIdToCId[-1] = emptyId;
+        Engine::clearTracedSignals();
+        Engine::edit([](Netlist &netlist) { netlist.clear(); });
     }
 
     std::shared_ptr<Components::Component> ComponentsManager::getComponent(const uuids::uuid &cid) {
@@ -202,6 +366,123 @@ namespace Bess::Simulator {
     }
 
     bool ComponentsManager::isRenderComponent(const int rId) {
-        return std::ranges::find(renderComponents, m_renderIdToCId[rId]) != renderComponents.end();
+        const auto cid = m_renderIdToCId.find(rId);
+        if (cid == m_renderIdToCId.end())
+            return false;
+        const auto comp = components.find(cid->second);
+        return comp != components.end() && ComponentStore::isRenderType(comp->second->getType());
+    }
+
+    void ComponentsManager::saveAsSubcircuit(const std::vector<uuids::uuid> &ids, const std::string &collection, const std::string &name) {
+        std::vector<Components::InputProbe *> inputProbes;
+        std::vector<Components::OutputProbe *> outputProbes;
+        std::vector<Components::JComponent *> pending;
+
+        for (auto &id : ids) {
+            auto &comp = components[id];
+            switch (comp->getType()) {
+            case ComponentType::inputProbe:
+                inputProbes.emplace_back((Components::InputProbe *)comp.get());
+                break;
+            case ComponentType::outputProbe:
+                outputProbes.emplace_back((Components::OutputProbe *)comp.get());
+                break;
+            case ComponentType::jcomponent:
+                pending.emplace_back((Components::JComponent *)comp.get());
+                break;
+            case ComponentType::clock:
+            case ComponentType::flipFlop:
+                throw std::runtime_error("Subcircuits can only contain combinational components, remove " + comp->getName());
+            case ComponentType::splitter:
+            case ComponentType::merger:
+                throw std::runtime_error("Subcircuits cannot contain bus components, remove " + comp->getName());
+            default:
+                break;
+            }
+        }
+
+        if (pending.empty())
+            throw std::runtime_error("Select the gates of the subcircuit");
+        if (outputProbes.empty())
+            throw std::runtime_error("Select at least one output probe to define the subcircuit outputs");
+        if (inputProbes.size() > Components::JComponentData::maxPorts || outputProbes.size() > Components::JComponentData::maxPorts)
+            throw std::runtime_error("Subcircuits have at most " + std::to_string(Components::JComponentData::maxPorts) + " inputs and outputs");
+
+        auto topToBottom = [](Components::Component *a, Components::Component *b) {
+            auto &pa = a->getPosition(), &pb = b->getPosition();
+            return pa.y != pb.y ? pa.y < pb.y : pa.x < pb.x;
+        };
+        std::ranges::sort(inputProbes, topToBottom);
+        std::ranges::sort(outputProbes, topToBottom);
+
+        // [gate, output] reference of every output slot inside the selection
+        std::unordered_map<uuids::uuid, nlohmann::json> sources;
+        std::unordered_map<uuids::uuid, Components::JComponent *> gateOfSlot;
+        for (int i = 0; i < inputProbes.size(); i++)
+            sources[inputProbes[i]->getOutputSlot()] = {Components::SubcircuitDefinition::inputSource, i};
+        for (auto gate : pending) {
+            for (auto &slot : gate->getOutputSlots())
+                gateOfSlot[slot] = gate;
+        }
+
+        // source feeding an input slot, empty while its driver is not placed yet
+        auto sourceOf = [&](const uuids::uuid &inputSlot, nlohmann::json &source) {
+            const auto connections = getConnectedSlots(inputSlot);
+            if (connections.empty()) {
+                source = nullptr;
+                return true;
+            }
+            if (connections.size() > 1)
+                throw std::runtime_error("Subcircuit inputs can only have one driver");
+            auto it = sources.find(connections.front());
+            if (it != sources.end()) {
+                source = it->second;
+                return true;
+            }
+            if (!gateOfSlot.contains(connections.front()))
+                throw std::runtime_error("A gate is driven from outside the selection, select an input probe for it instead");
+            return false;
+        };
+
+        // gates are saved after the gates driving them, passes over the rest
+        // stop making progress only when the selection has a loop
+        nlohmann::json gates = nlohmann::json::array();
+        while (!pending.empty()) {
+            auto placed = std::erase_if(pending, [&](Components::JComponent *gate) {
+                nlohmann::json gateInputs = nlohmann::json::array();
+                for (auto &slot : gate->getInputSlots()) {
+                    nlohmann::json source;
+                    if (!sourceOf(slot, source))
+                        return false;
+                    gateInputs.emplace_back(source);
+                }
+
+                auto &outputs = gate->getOutputSlots();
+                for (int i = 0; i < outputs.size(); i++)
+                    sources[outputs[i]] = {(int)gates.size(), i};
+
+                auto &data = gate->getData();
+                gates.push_back({{"collection", data->getCollectionName()}, {"name", data->getName()}, {"inputs", gateInputs}});
+                return true;
+            });
+            if (placed == 0)
+                throw std::runtime_error("Subcircuits cannot contain feedback loops");
+        }
+
+        nlohmann::json outputs = nlohmann::json::array();
+        std::vector<std::string> labels;
+        for (auto probe : outputProbes) {
+            nlohmann::json source;
+            sourceOf(probe->getInputSlot(), source);
+            outputs.emplace_back(source);
+            labels.emplace_back(outputProbes.size() == 1 ? "Y" : "Y" + std::to_string(labels.size()));
+        }
+
+        nlohmann::json entry;
+        entry["name"] = name;
+        entry["inputCount"] = inputProbes.size();
+        entry["outputs"] = labels;
+        entry["subcircuit"] = {{"gates", gates}, {"outputs", outputs}};
+        ComponentBank::saveToCollection(collection, entry);
     }
 } // namespace Bess::Simulator
@@ -0,0 +1,130 @@
+#include "components_manager/connection_index.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Bess::Simulator {
+
+    uint64_t ConnectionIndex::pairKey(uint32_t input, uint32_t output) {
+        return (uint64_t(input) << 32) | output;
+    }
+
+    uint32_t ConnectionIndex::acquirePin(const uuids::uuid &slot) {
+        if (const auto it = m_pinIds.find(slot); it != m_pinIds.end())
+            return it->second;
+
+        uint32_t pin;
+        if (m_freePins.empty()) {
+            pin = m_pins.size();
+            m_pins.emplace_back();
+        } else {
+            pin = m_freePins.back();
+            m_freePins.pop_back();
+        }
+        m_pins[pin].uid = slot;
+        m_pinIds[slot] = pin;
+        return pin;
+    }
+
+    void ConnectionIndex::releaseWire(uint32_t pin, uint32_t wire) {
+        auto &wires = m_pins[pin].wires;
+        wires.erase(std::ranges::find(wires, wire));
+        if (!wires.empty())
+            return;
+        // slots without connections give their id back
+        m_pinIds.erase(m_pins[pin].uid);
+        m_freePins.emplace_back(pin);
+    }
+
+    int64_t ConnectionIndex::findPin(const uuids::uuid &slot) const {
+        const auto it = m_pinIds.find(slot);
+        return it == m_pinIds.end() ? -1 : int64_t(it->second);
+    }
+
+    void ConnectionIndex::add(const uuids::uuid &inputSlot, const uuids::uuid &outputSlot, const uuids::uuid &connection) {
+        if (const auto &existing = getConnection(inputSlot, outputSlot); !existing.is_nil())
+            remove(existing);
+
+        const uint32_t input = acquirePin(inputSlot), output = acquirePin(outputSlot);
+
+        uint32_t wire;
+        if (m_freeWires.empty()) {
+            wire = m_wires.size();
+            m_wires.emplace_back();
+        } else {
+            wire = m_freeWires.back();
+            m_freeWires.pop_back();
+        }
+        m_wires[wire] = {connection, input, output};
+        m_wireIds[connection] = wire;
+
+        m_pins[input].wires.emplace_back(wire);
+        m_pins[output].wires.emplace_back(wire);
+        m_pairToWire[pairKey(input, output)] = wire;
+    }
+
+    void ConnectionIndex::remove(const uuids::uuid &connection) {
+        const auto it = m_wireIds.find(connection);
+        if (it == m_wireIds.end())
+            return;
+        const uint32_t wire = it->second;
+        const auto [uid, input, output] = m_wires[wire];
+
+        m_pairToWire.erase(pairKey(input, output));
+        releaseWire(input, wire);
+        releaseWire(output, wire);
+        m_wireIds.erase(it);
+        m_freeWires.emplace_back(wire);
+    }
+
+    void ConnectionIndex::clear() {
+        m_pins.clear();
+        m_freePins.clear();
+        m_pinIds.clear();
+        m_wires.clear();
+        m_freeWires.clear();
+        m_wireIds.clear();
+        m_pairToWire.clear();
+    }
+
+    const uuids::uuid &ConnectionIndex::getConnection(const uuids::uuid &inputSlot, const uuids::uuid &outputSlot) const {
+        static const uuids::uuid none{};
+        const auto input = findPin(inputSlot), output = findPin(outputSlot);
+        if (input < 0 || output < 0)
+            return none;
+        const auto it = m_pairToWire.find(pairKey(input, output));
+        return it == m_pairToWire.end() ? none : m_wires[it->second].uid;
+    }
+
+    std::pair<uuids::uuid, uuids::uuid> ConnectionIndex::getSlots(const uuids::uuid &connection) const {
+        const auto it = m_wireIds.find(connection);
+        if (it == m_wireIds.end())
+            throw std::runtime_error("Abandoned Connection");
+        const auto &wire = m_wires[it->second];
+        return {m_pins[wire.input].uid, m_pins[wire.output].uid};
+    }
+
+    std::vector<uuids::uuid> ConnectionIndex::getConnections(const uuids::uuid &slot) const {
+        std::vector<uuids::uuid> connections;
+        if (const auto pin = findPin(slot); pin >= 0) {
+            for (const auto wire : m_pins[pin].wires)
+                connections.emplace_back(m_wires[wire].uid);
+        }
+        return connections;
+    }
+
+    std::vector<uuids::uuid> ConnectionIndex::getConnectedSlots(const uuids::uuid &slot) const {
+        std::vector<uuids::uuid> slots;
+        if (const auto pin = findPin(slot); pin >= 0) {
+            for (const auto wire : m_pins[pin].wires) {
+                const auto &w = m_wires[wire];
+                slots.emplace_back(m_pins[w.input == pin ? w.output : w.input].uid);
+            }
+        }
+        return slots;
+    }
+
+    bool ConnectionIndex::isConnected(const uuids::uuid &slotA, const uuids::uuid &slotB) const {
+        return !getConnection(slotA, slotB).is_nil() || !getConnection(slotB, slotA).is_nil();
+    }
+} // namespace Bess::Simulator
@@ -1,13 +1,48 @@
 #include "components_manager/jcomponent_data.h"
 
+#include <stdexcept>
+
 namespace Bess::Simulator::Components {
 	JComponentData::JComponentData(const nlohmann::json& data, const std::string& collectionName) {
 		m_name = data["name"];
 		m_collectionName = collectionName;
 		m_inputCount = data["inputCount"];
-		for (auto& expr : data["outputs"]) {
-			m_outputs.emplace_back(expr);
+		if (m_inputCount > maxPorts || data["outputs"].size() > maxPorts)
+			throw std::runtime_error(m_name + " has more than " + std::to_string(maxPorts) + " inputs or outputs");
+
+		if (data.contains("subcircuit")) {
+			for (auto& label : data["outputs"])
+				m_outputs.emplace_back(label);
+			m_subcircuit = std::make_shared<SubcircuitDefinition>(data["subcircuit"], m_inputCount, (int)m_outputs.size());
+		} else if (data.contains("inputWidths") || data.contains("outputWidths")) {
+			m_inputWidths = data.value("inputWidths", std::vector<int>{});
+			m_outputWidths = data.value("outputWidths", std::vector<int>{});
+			m_inputWidths.resize(m_inputCount, 1);
+			m_outputWidths.resize(data["outputs"].size(), 1);
+			for (auto width : m_inputWidths) {
+				if (width < 1 || width > maxWidth)
+					throw std::runtime_error("Port widths of " + m_name + " have to be between 1 and " + std::to_string(maxWidth));
+			}
+			for (auto width : m_outputWidths) {
+				if (width < 1 || width > maxWidth)
+					throw std::runtime_error("Port widths of " + m_name + " have to be between 1 and " + std::to_string(maxWidth));
+			}
+			for (auto& expr : data["outputs"]) {
+				m_outputs.emplace_back(expr);
+				m_wordOutputs.emplace_back(m_outputs.back(), m_inputCount);
+			}
+		} else {
+			for (auto& expr : data["outputs"]) {
+				m_outputs.emplace_back(expr);
+				m_compiledOutputs.emplace_back(m_outputs.back(), m_inputCount);
+			}
 		}
+
+		// a subcircuit takes as long as its slowest path unless the entry says otherwise
+		int delay = data.value("delay", m_subcircuit ? (int)m_subcircuit->getDepth() : 1);
+		if (delay < 1)
+			throw std::runtime_error("Delay of " + m_name + " has to be at least one tick");
+		m_delay = delay;
 	}
 
     const std::string& JComponentData::getName() const {
@@ -25,4 +60,77 @@ namespace Bess::Simulator::Components {
     const std::vector<std::string>& JComponentData::getOutputs() const {
         return m_outputs;
     }
+
+    const std::vector<CompiledExpression>& JComponentData::getCompiledOutputs() const {
+        return m_compiledOutputs;
+    }
+
+    uint64_t JComponentData::getDelay() const {
+        return m_delay;
+    }
+
+    bool JComponentData::isSubcircuit() const {
+        return m_subcircuit != nullptr;
+    }
+
+    bool JComponentData::isWord() const {
+        return !m_wordOutputs.empty();
+    }
+
+    int JComponentData::getInputWidth(int input) const {
+        return m_inputWidths.empty() ? 1 : m_inputWidths[input];
+    }
+
+    int JComponentData::getOutputWidth(int output) const {
+        return m_outputWidths.empty() ? 1 : m_outputWidths[output];
+    }
+
+    void JComponentData::evaluateWords(const uint64_t* inputs, uint64_t* outputs) const {
+        for (int i = 0; i < m_wordOutputs.size(); i++) {
+            const int width = m_outputWidths[i];
+            const uint64_t mask = width >= 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+            outputs[i] = m_wordOutputs[i].evaluate(inputs) & mask;
+        }
+    }
+
+    const std::shared_ptr<const SubcircuitDefinition>& JComponentData::getSubcircuit() const {
+        return m_subcircuit;
+    }
+
+    uint32_t JComponentData::evaluate(uint32_t inputs) const {
+        if (m_subcircuit)
+            return m_subcircuit->evaluate(inputs);
+
+        uint32_t outputs = 0;
+        for (int i = 0; i < m_compiledOutputs.size(); i++) {
+            if (m_compiledOutputs[i].evaluate(inputs))
+                outputs |= 1u << i;
+        }
+        return outputs;
+    }
+
+    void JComponentData::evaluateLanes(const uint64_t* inputs, uint64_t* outputs) const {
+        if (m_subcircuit) {
+            m_subcircuit->evaluateLanes(inputs, outputs);
+            return;
+        }
+
+        for (int i = 0; i < m_compiledOutputs.size(); i++)
+            outputs[i] = m_compiledOutputs[i].evaluateLanes(inputs);
+    }
+
+    nlohmann::json JComponentData::toJson() const {
+        nlohmann::json data;
+        data["name"] = m_name;
+        data["inputCount"] = m_inputCount;
+        data["outputs"] = m_outputs;
+        data["delay"] = m_delay;
+        if (isWord()) {
+            data["inputWidths"] = m_inputWidths;
+            data["outputWidths"] = m_outputWidths;
+        }
+        if (m_subcircuit)
+            data["subcircuit"] = m_subcircuit->toJson();
+        return data;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "components_manager/subcircuit_definition.h"
+
+#include "components_manager/component_bank.h"
+#include "components_manager/jcomponent_data.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Bess::Simulator::Components {
+
+    SubcircuitDefinition::SubcircuitDefinition(const nlohmann::json &json, int inputCount, int outputCount)
+        : m_json(json), m_inputCount(inputCount), m_signalCount(inputCount) {
+        // ticks from the subcircuit inputs to every signal
+        std::vector<uint64_t> depths(inputCount, 0);
+
+        auto source = [&](const nlohmann::json &ref) {
+            if (ref.is_null())
+                return -1;
+            int gate = ref.at(0), output = ref.at(1);
+            if (gate == inputSource) {
+                if (output < 0 || output >= m_inputCount)
+                    throw std::runtime_error("Subcircuit input " + std::to_string(output) + " does not exist");
+                return output;
+            }
+            if (gate < 0 || gate >= (int)m_gates.size())
+                throw std::runtime_error("Subcircuit gates have to be listed after the gates driving them");
+            if (output < 0 || output >= (int)m_gates[gate].data->getOutputs().size())
+                throw std::runtime_error("Subcircuit gate " + std::to_string(gate) + " has no output " + std::to_string(output));
+            return m_gates[gate].firstOutput + output;
+        };
+
+        for (auto &gateJson : json.at("gates")) {
+            auto data = ComponentBank::getJCompData(gateJson.at("collection"), gateJson.at("name"));
+            if (data == nullptr)
+                throw std::runtime_error("Subcircuit gate " + gateJson.at("name").get<std::string>() + " is not in the component bank");
+            if (data->isWord())
+                throw std::runtime_error("Subcircuits cannot contain bus components like " + data->getName());
+
+            Gate gate{data, {}, m_signalCount};
+            uint64_t depth = 0;
+            for (auto &ref : gateJson.at("inputs")) {
+                int signal = source(ref);
+                gate.inputs.emplace_back(signal);
+                if (signal >= 0)
+                    depth = std::max(depth, depths[signal]);
+            }
+            if (gate.inputs.size() != data->getInputCount())
+                throw std::runtime_error("Subcircuit gate " + data->getName() + " needs " + std::to_string(data->getInputCount()) + " inputs");
+
+            int outputs = data->getOutputs().size();
+            m_signalCount += outputs;
+            depths.resize(m_signalCount, depth + data->getDelay());
+            m_gates.emplace_back(std::move(gate));
+        }
+
+        for (auto &ref : json.at("outputs")) {
+            int signal = source(ref);
+            m_outputs.emplace_back(signal);
+            if (signal >= 0)
+                m_depth = std::max(m_depth, depths[signal]);
+        }
+        if (m_outputs.size() != outputCount)
+            throw std::runtime_error("Subcircuit has " + std::to_string(m_outputs.size()) + " outputs, expected " + std::to_string(outputCount));
+
+        if (m_inputCount <= maxTableInputs)
+            buildTruthTable();
+    }
+
+    uint32_t SubcircuitDefinition::evaluate(uint32_t inputs) const {
+        if (!m_truthTable.empty())
+            return m_truthTable[inputs];
+
+        uint64_t inputLanes[JComponentData::maxPorts], outputLanes[JComponentData::maxPorts];
+        for (int i = 0; i < m_inputCount; i++)
+            inputLanes[i] = (inputs >> i) & 1 ? ~uint64_t(0) : 0;
+        runGates(inputLanes, outputLanes);
+
+        uint32_t outputs = 0;
+        for (int i = 0; i < m_outputs.size(); i++)
+            outputs |= uint32_t(outputLanes[i] & 1) << i;
+        return outputs;
+    }
+
+    void SubcircuitDefinition::evaluateLanes(const uint64_t *inputs, uint64_t *outputs) const {
+        runGates(inputs, outputs);
+    }
+
+    void SubcircuitDefinition::runGates(const uint64_t *inputs, uint64_t *outputs) const {
+        // signal words of every definition being evaluated on this thread,
+        // nested subcircuits push their frame on top of their parent's
+        thread_local std::vector<uint64_t> signals;
+        const size_t base = signals.size();
+        signals.resize(base + m_signalCount);
+        std::copy(inputs, inputs + m_inputCount, signals.begin() + base);
+
+        uint64_t gateInputs[JComponentData::maxPorts], gateOutputs[JComponentData::maxPorts];
+        for (auto &gate : m_gates) {
+            for (int i = 0; i < gate.inputs.size(); i++)
+                gateInputs[i] = gate.inputs[i] < 0 ? 0 : signals[base + gate.inputs[i]];
+            gate.data->evaluateLanes(gateInputs, gateOutputs);
+            std::copy(gateOutputs, gateOutputs + gate.data->getOutputs().size(), signals.begin() + base + gate.firstOutput);
+        }
+
+        for (int i = 0; i < m_outputs.size(); i++)
+            outputs[i] = m_outputs[i] < 0 ? 0 : signals[base + m_outputs[i]];
+        signals.resize(base);
+    }
+
+    void SubcircuitDefinition::buildTruthTable() {
+        const uint32_t combinations = 1u << m_inputCount;
+        m_truthTable.assign(combinations, 0);
+
+        // 64 input combinations per pass, one per lane
+        uint64_t inputLanes[JComponentData::maxPorts], outputLanes[JComponentData::maxPorts];
+        for (uint32_t first = 0; first < combinations; first += 64) {
+            const uint32_t lanes = std::min<uint32_t>(64, combinations - first);
+            for (int i = 0; i < m_inputCount; i++) {
+                inputLanes[i] = 0;
+                for (uint32_t lane = 0; lane < lanes; lane++)
+                    inputLanes[i] |= uint64_t(((first + lane) >> i) & 1) << lane;
+            }
+            runGates(inputLanes, outputLanes);
+
+            for (uint32_t lane = 0; lane < lanes; lane++) {
+                uint32_t outputs = 0;
+                for (int i = 0; i < m_outputs.size(); i++)
+                    outputs |= uint32_t((outputLanes[i] >> lane) & 1) << i;
+                m_truthTable[first + lane] = outputs;
+            }
+        }
+    }
+
+    uint64_t SubcircuitDefinition::getDepth() const {
+        return m_depth;
+    }
+
+    const std::vector<SubcircuitDefinition::Gate> &SubcircuitDefinition::getGates() const {
+        return m_gates;
+    }
+
+    const nlohmann::json &SubcircuitDefinition::toJson() const {
+        return m_json;
+    }
+} // namespace Bess::Simulator::Components
@@ -3,18 +3,21 @@
 #include "common/types.h"
 #include "components/clock.h"
 #include "components/connection.h"
+#include "components_manager/command_journal.h"
+#include "components_manager/component_store.h"
 #include "components_manager/components_manager.h"
 #include "events/application_event.h"
 #include "ext/matrix_transform.hpp"
 #include "ext/vector_float2.hpp"
 #include "ext/vector_float3.hpp"
 #include "ext/vector_float4.hpp"
+#include "imgui.h"
 #include "pages/page_identifier.h"
 #include "scene/renderer/renderer.h"
+#include "scene/spatial_index.h"
 #include "settings/viewport_theme.h"
 #include "simulator/simulator_engine.h"
 #include "ui/ui_main/ui_main.h"
-#include <set>
 
 using namespace Bess::Renderer2D;
 
@@ -74,9 +77,19 @@ namespace Bess::Pages {
 
         Renderer::grid({0.f, 0.f, -2.f}, m_camera->getSpan(), -1, ViewportTheme::gridColor);
 
-        for (auto &id : Simulator::ComponentsManager::renderComponents) {
-            const auto &entity = Simulator::ComponentsManager::components[id];
-            entity->render();
+        // components away from the view are skipped, slots and labels may
+        // stick out of their body so the view is widened a little
+        const auto span = m_camera->getSpan() / 2.f + cullMargin;
+        const auto viewMin = m_camera->getPos() - span, viewMax = m_camera->getPos() + span;
+        for (const auto type : Simulator::ComponentStore::getRenderTypes()) {
+            const auto &objects = Simulator::ComponentStore::getArchetype(type).objects;
+            // a wire can be in view while both of its ends are culled
+            const bool cull = type != Simulator::ComponentType::connection;
+            for (size_t i = 0; i < objects.size(); i++) {
+                if (cull && !Scene::SpatialIndex::mayBeVisible(objects[i]->getRenderId(), viewMin, viewMax))
+                    continue;
+                objects[i]->render();
+            }
         }
 
         switch (m_state->getDrawMode()) {
@@ -147,37 +160,20 @@ namespace Bess::Pages {
         auto &dragData = m_state->getDragData();
 
         if (!dragData.isDragging) {
-            auto viewportMousePos = getViewportMousePos();
-            viewportMousePos.y = UI::UIMain::state.viewportSize.y - viewportMousePos.y;
-            int hoverId = m_normalFramebuffer->readIntFromColAttachment(1, static_cast<int>(viewportMousePos.x), static_cast<int>(viewportMousePos.y));
-            if (Simulator::ComponentsManager::renderComponents.size() == 0 && hoverId != -1) {
-                std::cout << "No render components found but hover id was " << hoverId << std::endl;
-                hoverId = -1;
-            }
+            const int hoverId = isCursorInViewport() ? Scene::SpatialIndex::pick(getNVPMousePos()) : -1;
             m_state->setHoveredId(hoverId);
         }
 
         if (m_state->shouldReadBulkIds()) {
             m_state->setReadBulkIds(false);
             m_state->clearBulkIds();
-            auto end = getViewportMousePos();
-            auto start = dragData.vpMousePos;
-            auto size = end - start;
-            glm::vec2 pos = {std::min(start.x, end.x), std::max(start.y, end.y)};
-            size = glm::abs(size);
-
-            int w = (int)size.x;
-            int h = (int)size.y;
-            int x = pos.x, y = UI::UIMain::state.viewportSize.y - pos.y;
-
-            auto ids = m_normalFramebuffer->readIntsFromColAttachment(1, x, y, w, h);
+            const auto start = dragData.dragOffset, end = getNVPMousePos();
+            const auto ids = Scene::SpatialIndex::query(glm::min(start, end), glm::max(start, end));
 
             if (ids.size() == 0)
                 return;
 
-            std::set<int> uniqueIds(ids.begin(), ids.end());
-
-            for (auto &id : uniqueIds) {
+            for (auto &id : ids) {
                 if (!Simulator::ComponentsManager::isRenderComponent(id))
                     continue;
                 m_state->addBulkId(Simulator::ComponentsManager::renderIdToCid(id));
@@ -208,6 +204,16 @@ namespace Bess::Pages {
             case ApplicationEventType::KeyPress: {
                 const auto data = event.getData<ApplicationEvent::KeyPressData>();
                 m_state->setKeyPressed(data.key, true);
+                // once per press, the bindings below repeat every frame. Text
+                // fields keep their own undo.
+                if (m_state->isKeyPressed(GLFW_KEY_LEFT_CONTROL) && !ImGui::GetIO().WantTextInput) {
+                    if (data.key == GLFW_KEY_Z && m_state->isKeyPressed(GLFW_KEY_LEFT_SHIFT))
+                        Simulator::CommandJournal::redo();
+                    else if (data.key == GLFW_KEY_Z)
+                        Simulator::CommandJournal::undo();
+                    else if (data.key == GLFW_KEY_Y)
+                        Simulator::CommandJournal::redo();
+                }
             } break;
             case ApplicationEventType::KeyRelease: {
                 const auto data = event.getData<ApplicationEvent::KeyReleaseData>();
@@ -220,12 +226,16 @@ namespace Bess::Pages {
 
         // key board bindings
         {
-            if (m_state->isKeyPressed(GLFW_KEY_DELETE)) {
-                for (auto &compId : m_state->getBulkIds()) {
+            if (m_state->isKeyPressed(GLFW_KEY_DELETE) && !m_state->isBulkIdEmpty()) {
+                // deleting removes the ids from the selection
+                const auto ids = m_state->getBulkIds();
+                Simulator::CommandJournal::beginGroup();
+                for (auto &compId : ids) {
                     if (compId == Simulator::ComponentsManager::emptyId)
                         continue;
                     Simulator::ComponentsManager::deleteComponent(compId);
                 }
+                Simulator::CommandJournal::endGroup();
             }
 
             if (m_state->isKeyPressed(GLFW_KEY_LEFT_CONTROL)) {
@@ -244,21 +254,17 @@ namespace Bess::Pages {
             Simulator::ComponentsManager::components[cid]->onEvent(e);
         }
 
-        for (auto &comp : Simulator::ComponentsManager::components) {
-            if (comp.second->getType() == Simulator::ComponentType::clock) {
-                const auto clockCmp = std::dynamic_pointer_cast<Simulator::Components::Clock>(comp.second);
-                clockCmp->update();
-            } else if (comp.second->getType() == Simulator::ComponentType::connection) {
-                const auto connCmp = std::dynamic_pointer_cast<Simulator::Components::Connection>(comp.second);
-                connCmp->update();
-            } else if (comp.second->getType() != Simulator::ComponentType::connectionPoint) {
-                comp.second->update();
-            }
+        // connection points are updated by their connection, components created
+        // or deleted by an event callback are picked up by the index loop
+        for (const auto type : Simulator::ComponentStore::getTypes()) {
+            if (type == Simulator::ComponentType::connectionPoint)
+                continue;
+            const auto &objects = Simulator::ComponentStore::getArchetype(type).objects;
+            for (size_t i = 0; i < objects.size(); i++)
+                objects[i]->update();
         }
 
-        if (!m_state->isSimulationPaused()) {
-            Simulator::Engine::Simulate();
-        }
+        Simulator::Engine::update();
     }
 
     glm::vec2 MainPage::getCameraPos() {
@@ -298,9 +304,19 @@ namespace Bess::Pages {
         } else if (dragData.isDragging && m_state->getDrawMode() == UI::Types::DrawMode::none) {
             auto cid = m_state->getBulkIdAt(0);
             auto comp = Simulator::ComponentsManager::getComponent(cid);
-            comp->setPosition({glm::vec2(comp->getPosition()), dragData.orinalEntPos.z});
+            const auto pos = comp->getPosition();
+            comp->setPosition({glm::vec2(pos), dragData.orinalEntPos.z});
+            Simulator::CommandJournal::recordMove(cid, pos, comp->getPosition());
+            m_state->clearDragData();
+        } else if (dragData.isDragging) {
             m_state->clearDragData();
         }
+
+        // the moves of the whole drag are one step, however the drag ended
+        if (m_dragGroupOpen) {
+            Simulator::CommandJournal::endGroup();
+            m_dragGroupOpen = false;
+        }
     }
 
     void MainPage::onLeftMouse(bool pressed) {
@@ -309,21 +325,20 @@ namespace Bess::Pages {
             m_lastUpdateTime = std::chrono::steady_clock::now();
         }
 
-        // update only on release when outside viewport
-        if (!pressed) m_leftMousePressed = pressed;
-
-        if (!isCursorInViewport())
-            return;
-
-        m_leftMousePressed = pressed;
-
+        // a release ends the drag even outside the viewport
         if (!pressed) {
+            m_leftMousePressed = pressed;
             auto& dragData = m_state->getDragData();
             if (dragData.isDragging) {
                 finishDragging();
             }
             return;
         }
+
+        if (!isCursorInViewport())
+            return;
+
+        m_leftMousePressed = pressed;
         auto &cid = Simulator::ComponentsManager::renderIdToCid(m_state->getHoveredId());
 
         if (Simulator::ComponentsManager::emptyId == cid) {
@@ -439,7 +454,7 @@ namespace Bess::Pages {
                     if (static_cast<int>(entity->getType()) <= 100)
                         return;
 
-                    auto &pos = entity->getPosition();
+                    const auto pos = entity->getPosition();
 
                     if (!dragData.isDragging) {
                         Types::DragData dragData{};
@@ -447,6 +462,8 @@ namespace Bess::Pages {
                         dragData.orinalEntPos = pos;
                         dragData.dragOffset = getNVPMousePos() - glm::vec2(pos);
                         m_state->setDragData(dragData);
+                        Simulator::CommandJournal::beginGroup();
+                        m_dragGroupOpen = true;
                     }
 
                     auto dPos = getNVPMousePos() - dragData.dragOffset;
@@ -454,6 +471,7 @@ namespace Bess::Pages {
                     dPos = glm::round(dPos / snap) * snap;
 
                     entity->setPosition({dPos, 9.f});
+                    Simulator::CommandJournal::recordMove(id, pos, entity->getPosition());
                 }
             } else if (m_state->getHoveredId() == -1) { // box selection when dragging in empty space
                 if (!dragData.isDragging) {
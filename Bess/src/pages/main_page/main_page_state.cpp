@@ -2,6 +2,7 @@
 #include "common/types.h"
 
 #include "components_manager/component_bank.h"
+#include "components_manager/component_store.h"
 #include "components_manager/components_manager.h"
 #include "pages/main_page/main_page.h"
 #include "simulator/simulator_engine.h"
@@ -26,6 +27,10 @@ namespace Bess::Pages {
     }
 
     void MainPageState::setHoveredId(int id) {
+        if (id != m_hoveredId) {
+            setComponentFlag(m_hoveredId, Simulator::ComponentStore::hoveredFlag, false);
+            setComponentFlag(id, Simulator::ComponentStore::hoveredFlag, true);
+        }
         m_prevHoveredId = m_hoveredId;
         m_hoveredId = id;
     }
@@ -54,6 +59,16 @@ namespace Bess::Pages {
         Simulator::ComponentsManager::components[uid]->onEvent(e);
     }
 
+    void MainPageState::setComponentFlag(const uuids::uuid &id, uint8_t flag, bool value) {
+        if (const auto it = Simulator::ComponentsManager::components.find(id); it != Simulator::ComponentsManager::components.end())
+            Simulator::ComponentStore::setFlag(it->second->getHandle(), flag, value);
+    }
+
+    void MainPageState::setComponentFlag(int renderId, uint8_t flag, bool value) {
+        if (renderId != -1 && Simulator::ComponentsManager::isRenderIdPresent(renderId))
+            setComponentFlag(Simulator::ComponentsManager::renderIdToCid(renderId), flag, value);
+    }
+
     void MainPageState::resetProjectState() {
         m_drawMode = UI::Types::DrawMode::none;
         m_bulkIds.clear();
@@ -62,7 +77,7 @@ namespace Bess::Pages {
 
         m_hoveredId = -1;
         m_prevHoveredId = -1;
-        m_simulationPaused = false;
+        setSimulationPaused(false);
 
         Simulator::ComponentsManager::reset();
         Simulator::Engine::clearQueue();
@@ -117,6 +132,7 @@ namespace Bess::Pages {
 
     void MainPageState::setSimulationPaused(bool paused) {
         m_simulationPaused = paused;
+        Simulator::Engine::setPaused(paused);
     }
 
     bool MainPageState::isSimulationPaused() {
@@ -181,6 +197,7 @@ namespace Bess::Pages {
 
     void MainPageState::addBulkId(const uuids::uuid &id) {
         m_bulkIds.emplace_back(id);
+        setComponentFlag(id, Simulator::ComponentStore::selectedFlag, true);
         addFocusEvent(id);
     }
 
@@ -188,6 +205,7 @@ namespace Bess::Pages {
         clearBulkIds();
         m_bulkIds = ids;
         for (const auto &id : m_bulkIds) {
+            setComponentFlag(id, Simulator::ComponentStore::selectedFlag, true);
             addFocusEvent(id);
         }
     }
@@ -195,6 +213,7 @@ namespace Bess::Pages {
     void MainPageState::setBulkId(const uuids::uuid &id) {
         clearBulkIds();
         m_bulkIds.emplace_back(id);
+        setComponentFlag(id, Simulator::ComponentStore::selectedFlag, true);
         addFocusEvent(id);
     }
 
@@ -204,6 +223,7 @@ namespace Bess::Pages {
 
     void MainPageState::clearBulkIds() {
         for (const auto &id : m_bulkIds) {
+            setComponentFlag(id, Simulator::ComponentStore::selectedFlag, false);
             addFocusLostEvent(id);
         }
         m_bulkIds.clear();
@@ -211,6 +231,7 @@ namespace Bess::Pages {
 
     void MainPageState::removeBulkId(const uuids::uuid &id, bool dispatchEvent) {
         m_bulkIds.erase(std::remove(m_bulkIds.begin(), m_bulkIds.end(), id), m_bulkIds.end());
+        setComponentFlag(id, Simulator::ComponentStore::selectedFlag, false);
         if (dispatchEvent)
             addFocusLostEvent(id);
     }
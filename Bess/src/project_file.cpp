@@ -1,11 +1,6 @@
 #include "project_file.h"
 #include "common/helpers.h"
-#include "components/clock.h"
-#include "components/flip_flops/flip_flop.h"
-#include "components/input_probe.h"
 #include "components/jcomponent.h"
-#include "components/output_probe.h"
-#include "components/text_component.h"
 #include "components_manager/component_type.h"
 #include "components_manager/components_manager.h"
 #include "json.hpp"
@@ -81,44 +76,28 @@ namespace Bess {
     nlohmann::json ProjectFile::encode() {
         nlohmann::json data;
         data["name"] = m_name;
+        // subcircuit definitions are stored once, however many instances use them
+        std::vector<std::shared_ptr<Simulator::Components::JComponentData>> used;
         for (auto &kvp : Simulator::ComponentsManager::components) {
             auto ent = kvp.second;
-            switch (ent->getType()) {
-            case Bess::Simulator::ComponentType::inputProbe: {
-                auto comp = (Bess::Simulator::Components::InputProbe *)ent.get();
-                data["components"].emplace_back(comp->toJson());
-            } break;
-            case Bess::Simulator::ComponentType::outputProbe: {
-                auto comp = (Bess::Simulator::Components::OutputProbe *)ent.get();
-                data["components"].emplace_back(comp->toJson());
-            } break;
-            case Bess::Simulator::ComponentType::jcomponent: {
-
-                auto comp = (Bess::Simulator::Components::JComponent *)ent.get();
-                data["components"].emplace_back(comp->toJson());
-            } break;
-            case Bess::Simulator::ComponentType::text: {
-
-                auto comp = (Bess::Simulator::Components::TextComponent *)ent.get();
-                data["components"].emplace_back(comp->toJson());
-            } break;
-            case Bess::Simulator::ComponentType::clock: {
-                auto comp = (Bess::Simulator::Components::Clock *)ent.get();
-                data["components"].emplace_back(comp->toJson());
-            } break;
-            case Bess::Simulator::ComponentType::flipFlop: {
-                auto comp = (Bess::Simulator::Components::FlipFlop *)ent.get();
-                data["components"].emplace_back(comp->toJson());
-            } break;
-            case Bess::Simulator::ComponentType::connectionPoint: {
+            if (ent->getType() == Bess::Simulator::ComponentType::connectionPoint) {
                 auto comp = (Bess::Simulator::Components::ConnectionPoint *)ent.get();
                 data["connectionPoints"].emplace_back(comp->toJson());
+                continue;
             }
-            default:
-                break;
-            }
+
+            auto compJson = Simulator::ComponentsManager::componentToJson(kvp.first);
+            if (compJson.is_null())
+                continue;
+            data["components"].emplace_back(compJson);
+            if (ent->getType() == Bess::Simulator::ComponentType::jcomponent)
+                used.emplace_back(((Bess::Simulator::Components::JComponent *)ent.get())->getData());
         }
 
+        auto subcircuits = Simulator::ComponentBank::getSubcircuitEntries(used);
+        if (!subcircuits.empty())
+            data["subcircuits"] = subcircuits;
+
         return data;
     }
 
@@ -126,33 +105,12 @@ namespace Bess {
         std::ifstream file(m_path);
         nlohmann::json data = nlohmann::json::parse(file);
         m_name = data["name"];
+        if (data.contains("subcircuits"))
+            Simulator::ComponentBank::loadSubcircuitEntries(data["subcircuits"]);
         auto &components = data["components"];
 
         for (auto &comp : components) {
-            auto compType = Common::Helpers::intToCompType(comp["type"]);
-
-            switch (compType) {
-            case Bess::Simulator::ComponentType::inputProbe:
-                Simulator::Components::InputProbe::fromJson(comp);
-                break;
-            case Bess::Simulator::ComponentType::outputProbe:
-                Simulator::Components::OutputProbe::fromJson(comp);
-                break;
-            case Bess::Simulator::ComponentType::jcomponent:
-                Simulator::Components::JComponent::fromJson(comp);
-                break;
-            case Bess::Simulator::ComponentType::text:
-                Simulator::Components::TextComponent::fromJson(comp);
-                break;
-            case Bess::Simulator::ComponentType::clock:
-                Simulator::Components::Clock::fromJson(comp);
-                break;
-            case Bess::Simulator::ComponentType::flipFlop:
-                Simulator::Components::FlipFlop::fromJson(comp);
-                break;
-            default:
-                break;
-            }
+            Simulator::ComponentsManager::componentFromJson(comp);
         }
 
         for (auto &comp : data["connectionPoints"]) {
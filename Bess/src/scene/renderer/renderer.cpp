@@ -6,6 +6,7 @@
 #include "scene/renderer/gl/gl_wrapper.h"
 #include "scene/renderer/gl/primitive_type.h"
 #include "scene/renderer/gl/vertex.h"
+#include "scene/spatial_index.h"
 #include "ui/ui_main/ui_main.h"
 #include <GL/gl.h>
 #include <GLFW/glfw3.h>
@@ -242,6 +243,7 @@ namespace Bess {
         vertices[3].texCoord = {1.0f, 1.0f};
 
         addQuadVertices(vertices);
+        Scene::SpatialIndex::addQuad(id, pos, size, angle);
     }
 
     void Renderer::grid(const glm::vec3 &pos, const glm::vec2 &size, int id, const glm::vec4 &color) {
@@ -332,6 +334,7 @@ namespace Bess {
         vertices[3].texCoord = {1.0f, 1.0f};
 
         addCurveVertices(vertices);
+        Scene::SpatialIndex::addQuad(id, {pos, start.z}, size, angle);
     }
 
     int Renderer::calculateSegments(const glm::vec2 &p1, const glm::vec2 &p2) {
@@ -404,6 +407,7 @@ namespace Bess {
         vertices[3].texCoord = {1.0f, 1.0f};
 
         addCircleVertices(vertices);
+        Scene::SpatialIndex::addCircle(id, center, radius);
     }
 
     void Renderer::text(const std::string &text, const glm::vec3 &pos, const size_t size, const glm::vec4 &color, const int id) {
@@ -420,6 +424,7 @@ namespace Bess {
         shader->setUniform1i("u_SelectedObjId", -1);
 
         float scale = Font::getScale(size), x = pos.x, y = pos.y;
+        glm::vec2 textMin = glm::vec2(pos), textMax = glm::vec2(pos);
 
         for (auto &c : text) {
             auto &ch = m_Font->getCharacter(c);
@@ -429,6 +434,8 @@ namespace Bess {
 
             float w = ch.Size.x * scale;
             float h = ch.Size.y * scale;
+            textMin = glm::min(textMin, {xpos, ypos - h});
+            textMax = glm::max(textMax, {xpos + w, ypos});
 
             std::vector<Gl::Vertex> vertices(4);
 
@@ -453,6 +460,7 @@ namespace Bess {
             Gl::Api::drawElements(GL_TRIANGLES, (GLsizei)(vertices.size() / 4) * 6);
             x += (ch.Advance >> 6) * scale;
         }
+        Scene::SpatialIndex::addQuad(id, {(textMin + textMax) / 2.f, pos.z}, textMax - textMin, 0.f);
     }
 
     void Renderer2D::Renderer::line(const glm::vec3 &start, const glm::vec3 &end, float size, const glm::vec4 &color, const int id) {
@@ -620,6 +628,7 @@ namespace Bess {
     void Renderer::begin(std::shared_ptr<Camera> camera) {
         m_camera = camera;
         Gl::Api::clearStats();
+        Scene::SpatialIndex::beginFrame();
     }
 
     QuadBezierCurvePoints Renderer::generateQuadBezierPoints(const glm::vec2 &prevPoint, const glm::vec2 &joinPoint, const glm::vec2 &nextPoint, float curveRadius) {
@@ -637,6 +646,7 @@ namespace Bess {
         for (auto primitive : m_AvailablePrimitives) {
             flush(primitive);
         }
+        Scene::SpatialIndex::endFrame();
     }
 
     glm::vec2 Renderer2D::Renderer::getCharRenderSize(char ch, float renderSize) {
@@ -0,0 +1,187 @@
+#include "scene/spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Bess::Scene {
+
+    std::unordered_map<int, SpatialIndex::Entry> SpatialIndex::m_entries;
+    std::unordered_map<uint64_t, std::vector<int>> SpatialIndex::m_cells;
+    std::vector<int> SpatialIndex::m_drawn;
+    uint64_t SpatialIndex::m_frame = 0;
+
+    uint64_t SpatialIndex::cellKey(int x, int y) {
+        return (uint64_t(uint32_t(x)) << 32) | uint32_t(y);
+    }
+
+    glm::ivec2 SpatialIndex::cellOf(const glm::vec2 &point) {
+        return glm::ivec2(glm::floor(point / cellSize));
+    }
+
+    void SpatialIndex::bounds(const Shape &shape, glm::vec2 &min, glm::vec2 &max) {
+        glm::vec2 extent = shape.halfSize;
+        if (shape.circle) {
+            extent = glm::vec2(shape.halfSize.x);
+        } else if (shape.angle != 0.f) {
+            const float c = std::abs(std::cos(shape.angle)), s = std::abs(std::sin(shape.angle));
+            extent = {c * shape.halfSize.x + s * shape.halfSize.y, s * shape.halfSize.x + c * shape.halfSize.y};
+        }
+        min = shape.center - extent;
+        max = shape.center + extent;
+    }
+
+    bool SpatialIndex::contains(const Shape &shape, const glm::vec2 &point) {
+        glm::vec2 d = point - shape.center;
+        if (shape.circle)
+            return glm::dot(d, d) <= shape.halfSize.x * shape.halfSize.x;
+        if (shape.angle != 0.f) {
+            // into the frame of the quad
+            const float c = std::cos(shape.angle), s = std::sin(shape.angle);
+            d = {c * d.x + s * d.y, -s * d.x + c * d.y};
+        }
+        return std::abs(d.x) <= shape.halfSize.x && std::abs(d.y) <= shape.halfSize.y;
+    }
+
+    void SpatialIndex::unlink(int id, Entry &entry) {
+        for (const auto key : entry.cells) {
+            auto &ids = m_cells[key];
+            ids.erase(std::ranges::find(ids, id));
+            if (ids.empty())
+                m_cells.erase(key);
+        }
+        entry.cells.clear();
+    }
+
+    void SpatialIndex::link(int id, Entry &entry) {
+        entry.min = glm::vec2(INFINITY);
+        entry.max = glm::vec2(-INFINITY);
+        for (const auto &shape : entry.shapes) {
+            glm::vec2 min, max;
+            bounds(shape, min, max);
+            entry.min = glm::min(entry.min, min);
+            entry.max = glm::max(entry.max, max);
+
+            const auto first = cellOf(min), last = cellOf(max);
+            for (int x = first.x; x <= last.x; x++) {
+                for (int y = first.y; y <= last.y; y++) {
+                    const auto key = cellKey(x, y);
+                    auto &ids = m_cells[key];
+                    // shapes of one id overlap the same cells often
+                    if (!ids.empty() && ids.back() == id)
+                        continue;
+                    ids.emplace_back(id);
+                    entry.cells.emplace_back(key);
+                }
+            }
+        }
+    }
+
+    void SpatialIndex::beginFrame() {
+        m_frame++;
+        m_drawn.clear();
+    }
+
+    void SpatialIndex::add(int id, const Shape &shape) {
+        if (id < 0)
+            return;
+        auto &entry = m_entries[id];
+        if (entry.frame != m_frame) {
+            entry.frame = m_frame;
+            entry.pending.clear();
+            m_drawn.emplace_back(id);
+        }
+        entry.pending.emplace_back(shape);
+    }
+
+    void SpatialIndex::addQuad(int id, const glm::vec3 &center, const glm::vec2 &size, float angle) {
+        add(id, {glm::vec2(center), glm::abs(size) / 2.f, angle, center.z, false});
+    }
+
+    void SpatialIndex::addCircle(int id, const glm::vec3 &center, float radius) {
+        add(id, {glm::vec2(center), {radius, radius}, 0.f, center.z, true});
+    }
+
+    void SpatialIndex::endFrame() {
+        for (const auto id : m_drawn) {
+            auto &entry = m_entries[id];
+            entry.dirty = false;
+            if (entry.pending == entry.shapes)
+                continue;
+            unlink(id, entry);
+            std::swap(entry.shapes, entry.pending);
+            link(id, entry);
+        }
+    }
+
+    void SpatialIndex::remove(int id) {
+        const auto it = m_entries.find(id);
+        if (it == m_entries.end())
+            return;
+        unlink(id, it->second);
+        m_entries.erase(it);
+    }
+
+    void SpatialIndex::invalidate(int id) {
+        if (const auto it = m_entries.find(id); it != m_entries.end())
+            it->second.dirty = true;
+    }
+
+    void SpatialIndex::clear() {
+        m_entries.clear();
+        m_cells.clear();
+        m_drawn.clear();
+    }
+
+    int SpatialIndex::pick(const glm::vec2 &point) {
+        const auto cell = cellOf(point);
+        const auto it = m_cells.find(cellKey(cell.x, cell.y));
+        if (it == m_cells.end())
+            return -1;
+
+        int picked = -1;
+        float pickedZ = -INFINITY;
+        for (const auto id : it->second) {
+            for (const auto &shape : m_entries[id].shapes) {
+                if (shape.z >= pickedZ && contains(shape, point)) {
+                    picked = id;
+                    pickedZ = shape.z;
+                }
+            }
+        }
+        return picked;
+    }
+
+    std::vector<int> SpatialIndex::query(const glm::vec2 &min, const glm::vec2 &max) {
+        std::vector<int> candidates;
+        const auto first = cellOf(min), last = cellOf(max);
+        for (int x = first.x; x <= last.x; x++) {
+            for (int y = first.y; y <= last.y; y++) {
+                if (const auto it = m_cells.find(cellKey(x, y)); it != m_cells.end())
+                    candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+            }
+        }
+        std::ranges::sort(candidates);
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        std::vector<int> ids;
+        for (const auto id : candidates) {
+            for (const auto &shape : m_entries[id].shapes) {
+                glm::vec2 shapeMin, shapeMax;
+                bounds(shape, shapeMin, shapeMax);
+                if (shapeMin.x <= max.x && shapeMax.x >= min.x && shapeMin.y <= max.y && shapeMax.y >= min.y) {
+                    ids.emplace_back(id);
+                    break;
+                }
+            }
+        }
+        return ids;
+    }
+
+    bool SpatialIndex::mayBeVisible(int id, const glm::vec2 &min, const glm::vec2 &max) {
+        const auto it = m_entries.find(id);
+        if (it == m_entries.end() || it->second.dirty || it->second.shapes.empty())
+            return true;
+        const auto &entry = it->second;
+        return entry.min.x <= max.x && entry.max.x >= min.x && entry.min.y <= max.y && entry.max.y >= min.y;
+    }
+} // namespace Bess::Scene
@@ -15,6 +15,7 @@ namespace Bess {
     glm::vec4 ViewportTheme::gridColor;
     glm::vec4 ViewportTheme::selectionBoxBorderColor;
     glm::vec4 ViewportTheme::selectionBoxFillColor;
+    glm::vec4 ViewportTheme::oscillatingColor;
 
     void ViewportTheme::updateColorsFromImGuiStyle() {
         ImGuiStyle &style = ImGui::GetStyle();
@@ -48,6 +49,7 @@ namespace Bess {
         stateHighColor = glm::vec4(0.42f, 0.72f, 0.42f, 1.00f);
         stateLowColor = glm::vec4(0.82f, 0.2f, 0.2f, 1.00f);
         selectedWireColor = glm::vec4(1.0f, 0.64f, 0.0f, 1.0f);
+        oscillatingColor = glm::vec4(0.95f, 0.35f, 0.75f, 1.0f);
 
         selectionBoxBorderColor = glm::vec4({0.0, 0.3, 1.0, 1.f});
         selectionBoxFillColor = glm::vec4({0.0, 0.3, .7, .5f});
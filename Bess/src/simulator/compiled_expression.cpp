@@ -0,0 +1,164 @@
+#include "simulator/compiled_expression.h"
+
+#include <cctype>
+#include <stdexcept>
+
+namespace Bess::Simulator {
+
+    CompiledExpression::CompiledExpression(const std::string &expr, int inputCount) : m_inputCount(inputCount) {
+        if (inputCount > maxInputs)
+            throw std::out_of_range("Expressions support at most " + std::to_string(maxInputs) + " inputs");
+
+        // shunting-yard, emitting instructions instead of applying the operators
+        std::vector<char> operators = {};
+        int depth = 0;
+
+        auto precedence = [](char op) {
+            switch (op) {
+            case '!':
+                return 3;
+            case '*':
+                return 2;
+            case '^':
+                return 2;
+            case '+':
+                return 1;
+            default:
+                return 0;
+            }
+        };
+
+        auto emitTopOperator = [&]() {
+            char op = operators.back();
+            operators.pop_back();
+            switch (op) {
+            case '!':
+                if (depth < 1)
+                    throw std::runtime_error("Missing operand in expression");
+                m_program.push_back({OpCode::notOp, 0});
+                return;
+            case '*':
+                m_program.push_back({OpCode::andOp, 0});
+                break;
+            case '+':
+                m_program.push_back({OpCode::orOp, 0});
+                break;
+            case '^':
+                m_program.push_back({OpCode::xorOp, 0});
+                break;
+            default:
+                throw std::runtime_error("Unbalanced parentheses in expression");
+            }
+            if (depth < 2)
+                throw std::runtime_error("Missing operand in expression");
+            depth--;
+        };
+
+        for (size_t i = 0; i < expr.size(); ++i) {
+            if (isspace(expr[i]))
+                continue;
+
+            if (isdigit(expr[i])) {
+                int index = expr[i] - '0';
+                if (index >= inputCount) {
+                    throw std::out_of_range("Index out of range in the values array");
+                }
+                m_program.push_back({OpCode::input, static_cast<uint8_t>(index)});
+                if (++depth > maxStackDepth)
+                    throw std::runtime_error("Expression is too deeply nested");
+            } else if (expr[i] == '(') {
+                operators.push_back('(');
+            } else if (expr[i] == ')') {
+                while (!operators.empty() && operators.back() != '(') {
+                    emitTopOperator();
+                }
+                if (operators.empty())
+                    throw std::runtime_error("Unbalanced parentheses in expression");
+                operators.pop_back();
+            } else if (expr[i] == '+' || expr[i] == '*' || expr[i] == '^') {
+                while (!operators.empty() && precedence(operators.back()) >= precedence(expr[i])) {
+                    emitTopOperator();
+                }
+                operators.push_back(expr[i]);
+            } else if (expr[i] == '!') {
+                operators.push_back('!');
+            } else {
+                throw std::runtime_error("Invalid character in expression");
+            }
+        }
+
+        while (!operators.empty()) {
+            emitTopOperator();
+        }
+
+        if (depth != 1)
+            throw std::runtime_error("Malformed expression");
+
+        buildTruthTable();
+    }
+
+    void CompiledExpression::buildTruthTable() {
+        const uint32_t combinations = 1u << m_inputCount;
+        m_truthTable.assign((combinations + 63) / 64, 0);
+
+        // 64 input combinations are evaluated at once, one per bit lane
+        uint64_t inputs[maxInputs] = {};
+        for (uint32_t base = 0; base < combinations; base += 64) {
+            for (int i = 0; i < m_inputCount; i++) {
+                uint64_t word = 0;
+                for (uint32_t lane = 0; lane < 64; lane++) {
+                    if (((base + lane) >> i) & 1)
+                        word |= 1ull << lane;
+                }
+                inputs[i] = word;
+            }
+
+            uint64_t res = evaluateLanes(inputs);
+            if (combinations - base < 64)
+                res &= (1ull << (combinations - base)) - 1;
+            m_truthTable[base / 64] = res;
+        }
+    }
+
+    bool CompiledExpression::evaluate(uint32_t inputs) const {
+        return (m_truthTable[inputs >> 6] >> (inputs & 63)) & 1;
+    }
+
+    uint64_t CompiledExpression::evaluateLanes(const uint64_t *inputs) const {
+        uint64_t stack[maxStackDepth];
+        int top = -1;
+
+        for (const auto &ins : m_program) {
+            switch (ins.op) {
+            case OpCode::input:
+                stack[++top] = inputs[ins.operand];
+                break;
+            case OpCode::notOp:
+                stack[top] = ~stack[top];
+                break;
+            case OpCode::andOp:
+                stack[top - 1] &= stack[top];
+                top--;
+                break;
+            case OpCode::orOp:
+                stack[top - 1] |= stack[top];
+                top--;
+                break;
+            case OpCode::xorOp:
+                stack[top - 1] ^= stack[top];
+                top--;
+                break;
+            }
+        }
+
+        return stack[0];
+    }
+
+    const std::vector<CompiledExpression::Instruction> &CompiledExpression::getProgram() const {
+        return m_program;
+    }
+
+    int CompiledExpression::getInputCount() const {
+        return m_inputCount;
+    }
+} // namespace Bess::Simulator
@@ -0,0 +1,260 @@
+#include "simulator/headless_project.h"
+
+#include "components_manager/component_bank.h"
+#include "components_manager/component_type.h"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace Bess::Simulator {
+    namespace {
+        uuids::uuid toUUID(const nlohmann::json &data) {
+            auto uid = uuids::uuid::from_string(data.get<std::string>());
+            if (!uid.has_value())
+                throw std::runtime_error("Invalid uuid " + data.get<std::string>());
+            return uid.value();
+        }
+
+        // same names as the `name` of the classes in components/flip_flops,
+        // the component headers are not available to the headless targets
+        NodeKind flipFlopKind(const std::string &name) {
+            if (name == "JK Flip Flop")
+                return NodeKind::jkFlipFlop;
+            if (name == "D Flip Flop")
+                return NodeKind::dFlipFlop;
+            if (name == "D Register")
+                return NodeKind::dRegister;
+            if (name == "Counter")
+                return NodeKind::counter;
+            if (name == "Shift Register")
+                return NodeKind::shiftRegister;
+            if (name == "Register File")
+                return NodeKind::registerFile;
+            throw std::runtime_error("Unknown flip flop " + name);
+        }
+    } // namespace
+
+    HeadlessProject::HeadlessProject(const std::string &path) {
+        load(path);
+    }
+
+    void HeadlessProject::load(const std::string &path) {
+        std::ifstream file(path);
+        if (!file.good())
+            throw std::runtime_error("Could not open project " + path);
+
+        nlohmann::json data = nlohmann::json::parse(file);
+
+        m_netlist.clear();
+        m_inputPins.clear();
+        m_outputPins.clear();
+        m_clockPins.clear();
+        m_clockNodes.clear();
+        m_clockFrequencies.clear();
+        m_inputIds.clear();
+        m_outputIds.clear();
+        m_inputLabels.clear();
+        m_outputLabels.clear();
+        m_clockState = DigitalState::low;
+
+        m_name = data.value("name", "");
+        if (data.contains("subcircuits"))
+            ComponentBank::loadSubcircuitEntries(data["subcircuits"]);
+        for (auto &comp : data["components"]) {
+            loadComponent(comp);
+        }
+    }
+
+    void HeadlessProject::loadComponent(const nlohmann::json &data) {
+        auto type = static_cast<ComponentType>(data["type"].get<int>());
+        auto uid = toUUID(data["uid"]);
+
+        switch (type) {
+        case ComponentType::inputProbe: {
+            auto slot = loadSlot(data["slot"], ComponentType::outputSlot);
+            m_netlist.addNode(uid, NodeKind::inputProbe, {}, {slot});
+            m_inputPins.emplace_back(m_netlist.getPinId(slot));
+            m_inputIds.emplace_back(uid);
+            m_inputLabels.emplace_back(data.value("label", ""));
+        } break;
+        case ComponentType::outputProbe: {
+            auto slot = loadSlot(data["slot"], ComponentType::inputSlot);
+            m_netlist.addNode(uid, NodeKind::outputProbe, {slot}, {});
+            m_outputPins.emplace_back(m_netlist.getPinId(slot));
+            m_outputIds.emplace_back(uid);
+            m_outputLabels.emplace_back(data.value("label", ""));
+        } break;
+        case ComponentType::clock: {
+            auto slot = loadSlot(data["slot"], ComponentType::outputSlot);
+            m_clockNodes.emplace_back(m_netlist.addNode(uid, NodeKind::clock, {}, {slot}));
+            m_clockPins.emplace_back(m_netlist.getPinId(slot));
+
+            double frequency = data.value("frequency", 1.0);
+            switch (static_cast<FrequencyUnit>(data.value("frequencyUnit", 0))) {
+            case FrequencyUnit::kiloHertz:
+                frequency *= 1e3;
+                break;
+            case FrequencyUnit::megaHertz:
+                frequency *= 1e6;
+                break;
+            default:
+                break;
+            }
+            m_clockFrequencies.emplace_back(frequency);
+        } break;
+        case ComponentType::jcomponent: {
+            auto &jcomp = data["jCompData"];
+            auto compData = ComponentBank::getJCompData(jcomp["collection"], jcomp["name"]);
+            if (compData == nullptr)
+                throw std::runtime_error("Component " + jcomp["name"].get<std::string>() + " is not in the component bank");
+
+            auto inputs = loadSlots(data["inputSlots"], ComponentType::inputSlot);
+            auto outputs = loadSlots(data["outputSlots"], ComponentType::outputSlot);
+            m_netlist.addNode(uid, NodeKind::jcomponent, inputs, outputs, {}, compData.get());
+        } break;
+        case ComponentType::flipFlop: {
+            auto kind = flipFlopKind(data["name"]);
+            auto inputs = loadSlots(data["inputSlots"], ComponentType::inputSlot);
+            auto outputs = loadSlots(data["outputSlots"], ComponentType::outputSlot);
+            auto clock = loadSlot(data["clockSlot"], ComponentType::inputSlot);
+            int node = m_netlist.addNode(uid, kind, inputs, outputs, clock);
+            if (data.contains("clockEdge"))
+                m_netlist.setClockEdge(node, static_cast<ClockEdge>(data["clockEdge"].get<int>()));
+        } break;
+        case ComponentType::splitter: {
+            auto bus = loadSlot(data["busSlot"], ComponentType::inputSlot);
+            auto bits = loadSlots(data["bitSlots"], ComponentType::outputSlot);
+            m_netlist.addNode(uid, NodeKind::splitter, {bus}, bits);
+        } break;
+        case ComponentType::merger: {
+            auto bits = loadSlots(data["bitSlots"], ComponentType::inputSlot);
+            auto bus = loadSlot(data["busSlot"], ComponentType::outputSlot);
+            m_netlist.addNode(uid, NodeKind::merger, bits, {bus});
+        } break;
+        default:
+            break;
+        }
+    }
+
+    uuids::uuid HeadlessProject::loadSlot(const nlohmann::json &data, ComponentType type) {
+        // older projects saved some slots as their bare uid, the connections
+        // then only exist on the other end
+        if (data.is_string()) {
+            auto uid = toUUID(data);
+            m_netlist.addPin(uid, type);
+            return uid;
+        }
+
+        auto uid = toUUID(data["uid"]);
+        type = static_cast<ComponentType>(data["type"].get<int>());
+        m_netlist.addPin(uid, type);
+
+        // both ends store the connection, connecting from both sides covers
+        // the bare uid slots and the netlist ignores the duplicate
+        if (data.contains("connections")) {
+            for (auto &conn : data["connections"]) {
+                if (type == ComponentType::outputSlot)
+                    m_netlist.connect(uid, toUUID(conn));
+                else
+                    m_netlist.connect(toUUID(conn), uid);
+            }
+        }
+        return uid;
+    }
+
+    std::vector<uuids::uuid> HeadlessProject::loadSlots(const nlohmann::json &data, ComponentType type) {
+        std::vector<uuids::uuid> slots;
+        for (auto &slot : data) {
+            slots.emplace_back(loadSlot(slot, type));
+        }
+        return slots;
+    }
+
+    const std::string &HeadlessProject::getName() const {
+        return m_name;
+    }
+
+    size_t HeadlessProject::getInputCount() const {
+        return m_inputPins.size();
+    }
+
+    const uuids::uuid &HeadlessProject::getInputId(size_t index) const {
+        return m_inputIds.at(index);
+    }
+
+    std::string HeadlessProject::getInputLabel(size_t index) const {
+        const auto &label = m_inputLabels.at(index);
+        return label.empty() ? uuids::to_string(m_inputIds[index]) : label;
+    }
+
+    DigitalState HeadlessProject::getInput(size_t index) const {
+        return m_netlist.getPinState(m_inputPins.at(index));
+    }
+
+    void HeadlessProject::setInput(size_t index, DigitalState state) {
+        m_netlist.drivePin(m_inputPins.at(index), state);
+    }
+
+    int HeadlessProject::getInputPin(size_t index) const {
+        return m_inputPins.at(index);
+    }
+
+    size_t HeadlessProject::getOutputCount() const {
+        return m_outputPins.size();
+    }
+
+    const uuids::uuid &HeadlessProject::getOutputId(size_t index) const {
+        return m_outputIds.at(index);
+    }
+
+    std::string HeadlessProject::getOutputLabel(size_t index) const {
+        const auto &label = m_outputLabels.at(index);
+        return label.empty() ? uuids::to_string(m_outputIds[index]) : label;
+    }
+
+    DigitalState HeadlessProject::getOutput(size_t index) const {
+        return m_netlist.getPinState(m_outputPins.at(index));
+    }
+
+    int HeadlessProject::getOutputPin(size_t index) const {
+        return m_outputPins.at(index);
+    }
+
+    size_t HeadlessProject::getClockCount() const {
+        return m_clockPins.size();
+    }
+
+    double HeadlessProject::getClockFrequency(size_t index) const {
+        return m_clockFrequencies.at(index);
+    }
+
+    int HeadlessProject::getClockPin(size_t index) const {
+        return m_clockPins.at(index);
+    }
+
+    void HeadlessProject::setClocks(DigitalState state) {
+        m_clockState = state;
+        for (size_t i = 0; i < m_clockPins.size(); i++) {
+            m_netlist.setClockFrequency(m_clockNodes[i], 0.0);
+            m_netlist.drivePin(m_clockPins[i], state);
+        }
+    }
+
+    void HeadlessProject::toggleClocks() {
+        setClocks(!m_clockState);
+    }
+
+    void HeadlessProject::startClocks() {
+        for (size_t i = 0; i < m_clockNodes.size(); i++) {
+            m_netlist.setClockFrequency(m_clockNodes[i], m_clockFrequencies[i]);
+        }
+    }
+
+    void HeadlessProject::step(SimTime ticks) {
+        m_netlist.runFor(ticks);
+    }
+
+    Netlist &HeadlessProject::getNetlist() {
+        return m_netlist;
+    }
+} // namespace Bess::Simulator
@@ -0,0 +1,87 @@
+#include "simulator/lane_simulator.h"
+
+#include <algorithm>
+
+#include "components_manager/jcomponent_data.h"
+#include "simulator/compiled_expression.h"
+
+namespace Bess::Simulator {
+
+    LaneSimulator::LaneSimulator(const Netlist &netlist) : m_netlist(netlist) {
+        m_levels = Levelizer::levelize(netlist);
+
+        const auto pinCount = netlist.getPins().size();
+        m_pinLanes.resize(pinCount);
+        for (int pin = 0; pin < pinCount; pin++) {
+            m_pinLanes[pin] = netlist.getPinState(pin) == DigitalState::high ? ~0ull : 0ull;
+        }
+    }
+
+    void LaneSimulator::setPin(int pin, uint64_t lanes) {
+        m_pinLanes[pin] = lanes;
+    }
+
+    uint64_t LaneSimulator::getPin(int pin) const {
+        const auto &p = m_netlist.getPins()[pin];
+        if (p.type != ComponentType::inputSlot)
+            return m_pinLanes[pin];
+
+        // wired-or of all the drivers
+        uint64_t lanes = 0;
+        for (auto driver : p.connections)
+            lanes |= m_pinLanes[driver];
+        return lanes;
+    }
+
+    bool LaneSimulator::evaluate() {
+        for (const auto &level : m_levels.levels) {
+            for (auto node : level)
+                evaluateNode(node);
+        }
+
+        if (m_levels.cyclic.empty())
+            return true;
+
+        for (int pass = 0; pass < maxFeedbackPasses; pass++) {
+            bool changed = false;
+            for (auto node : m_levels.cyclic)
+                changed |= evaluateNode(node);
+            if (!changed)
+                return true;
+        }
+        return false;
+    }
+
+    bool LaneSimulator::evaluateNode(int id) {
+        const auto &node = m_netlist.getNodes()[id];
+
+        uint64_t inputs[Components::JComponentData::maxPorts];
+        uint64_t outputs[Components::JComponentData::maxPorts];
+        for (int i = 0; i < node.inputs.size(); i++)
+            inputs[i] = getPin(node.inputs[i]);
+
+        if (node.kind == NodeKind::lookupTable) {
+            // a table has no lane form, every lane reads its own entry
+            std::fill(outputs, outputs + node.outputs.size(), 0);
+            for (int lane = 0; lane < 64; lane++) {
+                uint32_t index = 0;
+                for (int i = 0; i < node.inputs.size(); i++)
+                    index |= uint32_t((inputs[i] >> lane) & 1) << i;
+                const uint32_t entry = node.table[index];
+                for (int i = 0; i < node.outputs.size(); i++)
+                    outputs[i] |= uint64_t((entry >> i) & 1) << lane;
+            }
+        } else {
+            node.jcompData->evaluateLanes(inputs, outputs);
+        }
+
+        bool changed = false;
+        for (int i = 0; i < node.outputs.size(); i++) {
+            auto lanes = outputs[i];
+            auto &pin = m_pinLanes[node.outputs[i]];
+            changed |= pin != lanes;
+            pin = lanes;
+        }
+        return changed;
+    }
+} // namespace Bess::Simulator
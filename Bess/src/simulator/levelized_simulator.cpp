@@ -0,0 +1,173 @@
+#include "simulator/levelized_simulator.h"
+
+#include "components_manager/jcomponent_data.h"
+
+namespace Bess::Simulator {
+
+    LevelizedSimulator::LevelizedSimulator(Netlist &netlist, size_t threadCount) : m_netlist(netlist), m_pool(threadCount) {
+        m_netlist.trackChanges(true);
+        m_netlist.setDeferredEvaluator(this);
+    }
+
+    LevelizedSimulator::~LevelizedSimulator() {
+        m_netlist.setDeferredEvaluator(nullptr);
+        m_netlist.trackChanges(false);
+    }
+
+    bool LevelizedSimulator::defers(int node) {
+        // levelizing on every edit would make loading a circuit quadratic
+        if (m_revision != m_netlist.getRevision()) {
+            m_stale = true;
+            return true;
+        }
+        return node < m_nodeLevels.size() && m_nodeLevels[node] >= 0;
+    }
+
+    void LevelizedSimulator::relevelize() {
+        if (m_revision == m_netlist.getRevision())
+            return;
+        m_levels = Levelizer::levelize(m_netlist);
+        m_revision = m_netlist.getRevision();
+
+        const auto nodeCount = m_netlist.getNodes().size();
+        m_nodeLevels.assign(nodeCount, -1);
+        for (int level = 0; level < m_levels.levels.size(); level++) {
+            for (auto id : m_levels.levels[level])
+                m_nodeLevels[id] = level;
+        }
+        m_dirty.assign(m_levels.levels.size(), {});
+        m_queued.assign(nodeCount, 0);
+        m_changed.assign(nodeCount, 0);
+    }
+
+    void LevelizedSimulator::markDirty(int node) {
+        if (node == Netlist::invalidId || node >= m_nodeLevels.size() || m_nodeLevels[node] < 0 || m_queued[node])
+            return;
+        m_queued[node] = 1;
+        m_dirty[m_nodeLevels[node]].emplace_back(node);
+    }
+
+    void LevelizedSimulator::collectChanges() {
+        m_netlist.takeChanges(m_changes);
+        const auto &nodes = m_netlist.getNodes();
+
+        // the nodes deferred by mistake go back to the event driven path
+        if (m_stale) {
+            m_stale = false;
+            for (auto node : m_changes.nodes) {
+                if (node < nodes.size() && nodes[node].alive && m_nodeLevels[node] < 0)
+                    m_netlist.scheduleNode(node);
+            }
+        }
+
+        if (m_evaluateAll) {
+            m_evaluateAll = false;
+            for (const auto &level : m_levels.levels) {
+                for (auto id : level)
+                    markDirty(id);
+            }
+            return;
+        }
+
+        // the log holds the deferred nodes the event driven path woke
+        for (auto node : m_changes.nodes) {
+            if (node < nodes.size() && nodes[node].alive)
+                markDirty(node);
+        }
+    }
+
+    const Levelization &LevelizedSimulator::getLevelization() {
+        relevelize();
+        return m_levels;
+    }
+
+    void LevelizedSimulator::evaluate() {
+        relevelize();
+        const bool first = m_evaluateAll;
+        collectChanges();
+
+        const auto &nodes = m_netlist.getNodes();
+        const auto &pins = m_netlist.getPins();
+        m_evaluated.clear();
+        for (auto &level : m_dirty) {
+            if (level.empty())
+                continue;
+
+            if (level.size() < parallelThreshold) {
+                for (auto node : level)
+                    evaluateNode(node);
+            } else {
+                m_pool.parallelFor(level.size(), grainSize, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++)
+                        evaluateNode(level[i]);
+                });
+            }
+
+            // dependants always sit on a later level
+            for (auto id : level) {
+                m_queued[id] = 0;
+                m_evaluated.emplace_back(id);
+                if (!m_changed[id])
+                    continue;
+                for (auto out : nodes[id].outputs) {
+                    for (auto in : pins[out].connections)
+                        markDirty(pins[in].node);
+                }
+            }
+            level.clear();
+        }
+
+        // the levelized outputs are final, changes still on the wheel are stale
+        for (auto id : m_evaluated) {
+            for (auto out : nodes[id].outputs) {
+                m_netlist.cancelPendingOutput(out);
+                if (!m_changed[id])
+                    continue;
+
+                for (auto in : pins[out].connections) {
+                    int dependant = pins[in].node;
+                    // levelized dependants already read the new state
+                    if (dependant == Netlist::invalidId || m_nodeLevels[dependant] < 0)
+                        m_netlist.updateInputPin(in);
+                }
+            }
+            m_changed[id] = 0;
+        }
+        m_evaluatedCount += m_evaluated.size();
+
+        // the loops have not seen the initial state of their inputs yet
+        if (first) {
+            for (auto id : m_levels.cyclic) {
+                for (auto in : nodes[id].inputs)
+                    m_netlist.updateInputPin(in);
+            }
+        }
+    }
+
+    size_t LevelizedSimulator::getEvaluatedCount() const {
+        return m_evaluatedCount;
+    }
+
+    void LevelizedSimulator::evaluateNode(int id) {
+        const auto &node = m_netlist.getNodes()[id];
+
+        // every pin written here belongs to this node, so nodes of the same
+        // level never write the same pin
+        uint32_t inputs = 0;
+        for (int i = 0; i < node.inputs.size(); i++) {
+            auto state = m_netlist.resolveDrivers(node.inputs[i]);
+            m_netlist.setPinState(node.inputs[i], state);
+            if (state == DigitalState::high)
+                inputs |= 1u << i;
+        }
+
+        auto outputs = Netlist::evaluateCombinational(node, inputs);
+        for (int i = 0; i < node.outputs.size(); i++) {
+            auto state = (outputs >> i) & 1 ? DigitalState::high : DigitalState::low;
+            if (m_netlist.getPinState(node.outputs[i]) == state)
+                continue;
+            m_netlist.setPinState(node.outputs[i], state);
+            m_changed[id] = 1;
+        }
+    }
+} // namespace Bess::Simulator
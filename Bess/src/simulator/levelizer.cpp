@@ -0,0 +1,140 @@
+#include "simulator/levelizer.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Bess::Simulator {
+
+    bool Levelizer::isCombinational(NodeKind kind) {
+        return kind == NodeKind::jcomponent || kind == NodeKind::lookupTable;
+    }
+
+    Levelization Levelizer::levelize(const Netlist &netlist) {
+        const auto &nodes = netlist.getNodes();
+        const auto &pins = netlist.getPins();
+
+        // Kahn's algorithm, a node is ready once all the combinational nodes
+        // driving its inputs have been ranked
+        std::vector<int> pendingInputs(nodes.size(), 0);
+        std::vector<int> ready = {};
+
+        for (int id = 0; id < nodes.size(); id++) {
+            const auto &node = nodes[id];
+            if (!node.alive || !isCombinational(node.kind))
+                continue;
+
+            for (auto pin : node.inputs) {
+                for (auto driver : pins[pin].connections) {
+                    int driverNode = pins[driver].node;
+                    if (driverNode != Netlist::invalidId && isCombinational(nodes[driverNode].kind))
+                        pendingInputs[id]++;
+                }
+            }
+
+            if (pendingInputs[id] == 0)
+                ready.emplace_back(id);
+        }
+
+        Levelization res;
+        while (!ready.empty()) {
+            std::vector<int> next = {};
+            for (auto id : ready) {
+                for (auto out : nodes[id].outputs) {
+                    for (auto in : pins[out].connections) {
+                        int dependant = pins[in].node;
+                        if (dependant == Netlist::invalidId || !isCombinational(nodes[dependant].kind))
+                            continue;
+                        if (--pendingInputs[dependant] == 0)
+                            next.emplace_back(dependant);
+                    }
+                }
+            }
+            res.levels.emplace_back(std::move(ready));
+            ready = std::move(next);
+        }
+
+        for (int id = 0; id < nodes.size(); id++) {
+            if (nodes[id].alive && isCombinational(nodes[id].kind) && pendingInputs[id] > 0)
+                res.cyclic.emplace_back(id);
+        }
+
+        return res;
+    }
+
+    std::vector<std::vector<int>> Levelizer::findLoops(const Netlist &netlist) {
+        const auto &nodes = netlist.getNodes();
+        const auto &pins = netlist.getPins();
+
+        // combinational nodes reading an output of `id`
+        auto forEachDependant = [&](int id, auto &&fn) {
+            for (auto out : nodes[id].outputs) {
+                for (auto in : pins[out].connections) {
+                    int dependant = pins[in].node;
+                    if (dependant != Netlist::invalidId && isCombinational(nodes[dependant].kind))
+                        fn(dependant);
+                }
+            }
+        };
+
+        // Tarjan's algorithm with an explicit stack, deep chains of gates
+        // would overflow the call stack
+        constexpr int unvisited = -1;
+        std::vector<int> index(nodes.size(), unvisited), lowLink(nodes.size(), 0);
+        std::vector<uint8_t> onStack(nodes.size(), 0);
+        std::vector<int> stack = {};
+        std::vector<std::pair<int, std::vector<int>>> frames = {};
+        int nextIndex = 0;
+
+        std::vector<std::vector<int>> loops;
+        for (int root = 0; root < nodes.size(); root++) {
+            if (!nodes[root].alive || !isCombinational(nodes[root].kind) || index[root] != unvisited)
+                continue;
+
+            auto visit = [&](int id) {
+                index[id] = lowLink[id] = nextIndex++;
+                stack.emplace_back(id);
+                onStack[id] = 1;
+                std::vector<int> dependants;
+                forEachDependant(id, [&](int dependant) { dependants.emplace_back(dependant); });
+                frames.emplace_back(id, std::move(dependants));
+            };
+            visit(root);
+
+            while (!frames.empty()) {
+                auto &[id, dependants] = frames.back();
+                if (!dependants.empty()) {
+                    int next = dependants.back();
+                    dependants.pop_back();
+                    if (index[next] == unvisited)
+                        visit(next);
+                    else if (onStack[next])
+                        lowLink[id] = std::min(lowLink[id], index[next]);
+                    continue;
+                }
+
+                const int done = id;
+                frames.pop_back();
+                if (!frames.empty())
+                    lowLink[frames.back().first] = std::min(lowLink[frames.back().first], lowLink[done]);
+                if (lowLink[done] != index[done])
+                    continue;
+
+                std::vector<int> component;
+                int member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack[member] = 0;
+                    component.emplace_back(member);
+                } while (member != done);
+
+                bool feedsItself = false;
+                if (component.size() == 1)
+                    forEachDependant(done, [&](int dependant) { feedsItself |= dependant == done; });
+                if (component.size() > 1 || feedsItself)
+                    loops.emplace_back(std::move(component));
+            }
+        }
+        return loops;
+    }
+} // namespace Bess::Simulator
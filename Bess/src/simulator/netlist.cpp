@@ -0,0 +1,1254 @@
+#include "simulator/netlist.h"
+
+#include "components_manager/jcomponent_data.h"
+#include "simulator/levelizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+namespace Bess::Simulator {
+
+    namespace {
+        uint64_t widthMask(int width) {
+            return width >= 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+        }
+    } // namespace
+
+    int Netlist::getOrAddPin(const uuids::uuid &uid) {
+        if (auto it = m_pinIds.find(uid); it != m_pinIds.end())
+            return it->second;
+
+        int id;
+        if (!m_freePins.empty()) {
+            id = m_freePins.back();
+            m_freePins.pop_back();
+        } else {
+            id = static_cast<int>(m_pins.size());
+            m_pins.emplace_back();
+            m_pinStates.emplace_back(DigitalState::low);
+            m_highDrivers.emplace_back(0);
+            m_pinWords.emplace_back(0);
+            m_pendingWords.emplace_back(0);
+            m_pinStamps.emplace_back(0);
+            m_pendingEvents.emplace_back(TimingWheel::invalidHandle);
+        }
+
+        auto &pin = m_pins[id];
+        pin = {};
+        pin.uid = uid;
+        pin.alive = true;
+        m_pinStates[id] = DigitalState::low;
+        m_highDrivers[id] = 0;
+        m_pinWords[id] = 0;
+        m_pinIds[uid] = id;
+        m_revision++;
+        return id;
+    }
+
+    int Netlist::addPin(const uuids::uuid &uid, ComponentType type) {
+        // pins can already exist when a connection to them was loaded first
+        int id = getOrAddPin(uid);
+        m_pins[id].type = type;
+        return id;
+    }
+
+    void Netlist::removePin(const uuids::uuid &uid) {
+        auto it = m_pinIds.find(uid);
+        if (it == m_pinIds.end())
+            return;
+        int id = it->second;
+        expandPin(id);
+        auto &pin = m_pins[id];
+        cancelPendingOutput(id);
+        m_revision++;
+
+        const bool high = m_pinStates[id] == DigitalState::high;
+        for (auto conn : pin.connections) {
+            auto &other = m_pins[conn].connections;
+            other.erase(std::remove(other.begin(), other.end(), id), other.end());
+            if (pin.type == ComponentType::outputSlot) {
+                if (high)
+                    m_highDrivers[conn]--;
+                schedulePin(conn);
+            }
+        }
+
+        // the node may run again before it is removed or added again, it must
+        // not reach the id once a new pin reuses it
+        if (pin.node != invalidId) {
+            auto &node = m_nodes[pin.node];
+            std::erase(node.inputs, id);
+            std::erase(node.outputs, id);
+            if (node.clockPin == id)
+                node.clockPin = invalidId;
+            scheduleNode(pin.node);
+        }
+
+        pin = {};
+        m_pinIds.erase(it);
+        m_freePins.emplace_back(id);
+    }
+
+    int Netlist::getPinId(const uuids::uuid &uid) const {
+        auto it = m_pinIds.find(uid);
+        return it == m_pinIds.end() ? invalidId : it->second;
+    }
+
+    const std::unordered_map<uuids::uuid, int> &Netlist::getPinIds() const {
+        return m_pinIds;
+    }
+
+    int Netlist::addNode(const uuids::uuid &uid, NodeKind kind,
+                         const std::vector<uuids::uuid> &inputs,
+                         const std::vector<uuids::uuid> &outputs,
+                         const uuids::uuid &clockPin,
+                         const Components::JComponentData *jcompData) {
+        removeNode(uid);
+
+        if (kind == NodeKind::jcomponent && jcompData != nullptr && jcompData->isWord())
+            kind = NodeKind::wordComponent;
+
+        int id = allocateNode();
+        auto &node = m_nodes[id];
+        node.kind = kind;
+        node.uid = uid;
+        node.alive = true;
+        node.jcompData = jcompData;
+        if (jcompData != nullptr)
+            node.delay = jcompData->getDelay();
+
+        for (auto &pinUid : inputs) {
+            int pin = getOrAddPin(pinUid);
+            m_pins[pin].node = id;
+            node.inputs.emplace_back(pin);
+        }
+
+        for (auto &pinUid : outputs) {
+            int pin = getOrAddPin(pinUid);
+            m_pins[pin].node = id;
+            node.outputs.emplace_back(pin);
+        }
+
+        if (!clockPin.is_nil()) {
+            node.clockPin = getOrAddPin(clockPin);
+            m_pins[node.clockPin].node = id;
+        }
+
+        if (isEdgeTriggered(kind)) {
+            // a register file's read address is the only input that is not
+            // sampled, it changes the output right away
+            size_t sampled = node.inputs.size();
+            if (kind == NodeKind::registerFile)
+                sampled -= getAddressBits(node);
+            for (size_t i = 0; i < sampled; i++)
+                m_pins[node.inputs[i]].sampled = true;
+
+            node.words.assign(kind == NodeKind::registerFile ? size_t(1) << getAddressBits(node) : 1, 0);
+        }
+
+        // bus pins take their width from the node
+        auto setWidth = [&](int pin, int width) {
+            m_pins[pin].width = static_cast<uint8_t>(std::clamp(width, 1, 64));
+        };
+        if (kind == NodeKind::splitter && !node.inputs.empty())
+            setWidth(node.inputs[0], static_cast<int>(node.outputs.size()));
+        else if (kind == NodeKind::merger && !node.outputs.empty())
+            setWidth(node.outputs[0], static_cast<int>(node.inputs.size()));
+        else if (kind == NodeKind::wordComponent) {
+            for (int i = 0; i < node.inputs.size(); i++)
+                setWidth(node.inputs[i], jcompData->getInputWidth(i));
+            for (int i = 0; i < node.outputs.size(); i++)
+                setWidth(node.outputs[i], jcompData->getOutputWidth(i));
+        }
+
+        m_nodeIds[uid] = id;
+        m_revision++;
+
+        if (kind == NodeKind::jcomponent || kind == NodeKind::wordComponent || kind == NodeKind::splitter || kind == NodeKind::merger)
+            scheduleNode(id);
+
+        return id;
+    }
+
+    int Netlist::allocateNode() {
+        int id;
+        if (!m_freeNodes.empty()) {
+            id = m_freeNodes.back();
+            m_freeNodes.pop_back();
+        } else {
+            id = static_cast<int>(m_nodes.size());
+            m_nodes.emplace_back();
+            m_nodeStamps.emplace_back(0);
+        }
+        m_nodes[id] = {};
+        return id;
+    }
+
+    void Netlist::removeNode(const uuids::uuid &uid) {
+        auto it = m_nodeIds.find(uid);
+        if (it == m_nodeIds.end())
+            return;
+        int id = it->second;
+        if (m_nodes[id].collapsedInto != invalidId)
+            expand(m_nodes[id].collapsedInto);
+        auto &node = m_nodes[id];
+        stopClock(id);
+
+        auto detach = [&](int pin) {
+            if (pin != invalidId && m_pins[pin].node == id) {
+                m_pins[pin].node = invalidId;
+                m_pins[pin].sampled = false;
+            }
+        };
+        std::ranges::for_each(node.inputs, detach);
+        std::ranges::for_each(node.outputs, detach);
+        detach(node.clockPin);
+
+        node = {};
+        m_nodeIds.erase(it);
+        m_freeNodes.emplace_back(id);
+        m_revision++;
+    }
+
+    int Netlist::getNodeId(const uuids::uuid &uid) const {
+        auto it = m_nodeIds.find(uid);
+        return it == m_nodeIds.end() ? invalidId : it->second;
+    }
+
+    void Netlist::setClockEdge(int node, ClockEdge edge) {
+        m_nodes[node].clockEdge = edge;
+    }
+
+    bool Netlist::isEdgeTriggered(NodeKind kind) {
+        switch (kind) {
+        case NodeKind::jkFlipFlop:
+        case NodeKind::dFlipFlop:
+        case NodeKind::dRegister:
+        case NodeKind::counter:
+        case NodeKind::shiftRegister:
+        case NodeKind::registerFile:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    int Netlist::getAddressBits(const Node &node) {
+        constexpr int maxAddressBits = 16;
+        const int bits = (static_cast<int>(node.inputs.size()) - static_cast<int>(node.outputs.size()) - 1) / 2;
+        return std::clamp(bits, 0, maxAddressBits);
+    }
+
+    void Netlist::setClockFrequency(int id, double hertz) {
+        auto &node = m_nodes[id];
+        stopClock(id);
+        if (hertz <= 0.0)
+            return;
+
+        // edges are placed from the start time so rounding never accumulates
+        node.clockHalfPeriod = std::max(double(ticksPerSecond) / (2.0 * hertz), 1.0);
+        node.clockStart = m_wheel.getTime();
+        node.clockEdges = 0;
+        scheduleClockEdge(id);
+    }
+
+    void Netlist::scheduleClockEdge(int id) {
+        auto &node = m_nodes[id];
+        const auto offset = static_cast<SimTime>(std::llround((node.clockEdges + 1) * node.clockHalfPeriod));
+        const SimTime time = std::max(node.clockStart + offset, m_wheel.getTime() + 1);
+        node.clockEvent = m_wheel.schedule(time, {id, SimEventType::node, DigitalState::low});
+    }
+
+    void Netlist::stopClock(int id) {
+        auto &node = m_nodes[id];
+        if (node.clockEvent != TimingWheel::invalidHandle)
+            m_wheel.cancel(node.clockEvent);
+        node.clockEvent = TimingWheel::invalidHandle;
+        node.clockHalfPeriod = 0.0;
+    }
+
+    int Netlist::collapse(const std::vector<uuids::uuid> &uids) {
+        std::vector<int> members;
+        // position of every member node in `members`
+        std::unordered_map<int, int> memberIndex;
+        for (auto &uid : uids) {
+            int id = getNodeId(uid);
+            if (id == invalidId || memberIndex.contains(id))
+                continue;
+            if (m_nodes[id].kind != NodeKind::jcomponent)
+                throw std::runtime_error("Only combinational components can be collapsed into a lookup table");
+            memberIndex[id] = static_cast<int>(members.size());
+            members.emplace_back(id);
+        }
+        if (members.empty())
+            throw std::runtime_error("Nothing to collapse, select the combinational components of the region");
+
+        auto inRegion = [&](int pin) { return memberIndex.contains(m_pins[pin].node); };
+
+        // Inputs of the table, one per distinct net driving the region from
+        // outside. The first pin of a net stays the input of the table node,
+        // the others become sampled so they do not wake anything.
+        std::vector<int> inputs;
+        std::map<std::vector<int>, int> inputOfNet;
+        std::unordered_map<int, int> tableInput;
+        for (auto id : members) {
+            for (auto pin : m_nodes[id].inputs) {
+                const auto &drivers = m_pins[pin].connections;
+                const auto internal = std::ranges::count_if(drivers, inRegion);
+                if (internal == 0 && !drivers.empty()) {
+                    auto net = drivers;
+                    std::ranges::sort(net);
+                    auto [it, added] = inputOfNet.try_emplace(std::move(net), static_cast<int>(inputs.size()));
+                    if (added)
+                        inputs.emplace_back(pin);
+                    tableInput[pin] = it->second;
+                } else if (internal != drivers.size()) {
+                    throw std::runtime_error("A net driving the region mixes drivers from inside and outside of it");
+                }
+            }
+        }
+        if (inputs.size() > maxLookupInputs)
+            throw std::runtime_error("The region has " + std::to_string(inputs.size()) + " inputs, at most " +
+                                     std::to_string(maxLookupInputs) + " can be collapsed");
+
+        // outputs read outside of the region first, internal wires fill the
+        // rest of the table entry so they keep showing their settled state
+        std::vector<int> outputs;
+        for (auto id : members) {
+            for (auto pin : m_nodes[id].outputs) {
+                if (!std::ranges::all_of(m_pins[pin].connections, inRegion))
+                    outputs.emplace_back(pin);
+            }
+        }
+        if (outputs.size() > Components::JComponentData::maxPorts)
+            throw std::runtime_error("The region drives more than " + std::to_string(Components::JComponentData::maxPorts) + " wires outside of it");
+        for (auto id : members) {
+            for (auto pin : m_nodes[id].outputs) {
+                if (outputs.size() < Components::JComponentData::maxPorts && std::ranges::find(outputs, pin) == outputs.end())
+                    outputs.emplace_back(pin);
+            }
+        }
+
+        // evaluation order, Kahn's algorithm over the wires inside the region
+        std::vector<int> pendingDrivers(members.size(), 0);
+        std::vector<int> order;
+        for (int i = 0; i < members.size(); i++) {
+            for (auto pin : m_nodes[members[i]].inputs)
+                pendingDrivers[i] += static_cast<int>(std::ranges::count_if(m_pins[pin].connections, inRegion));
+            if (pendingDrivers[i] == 0)
+                order.emplace_back(members[i]);
+        }
+        for (int i = 0; i < order.size(); i++) {
+            for (auto out : m_nodes[order[i]].outputs) {
+                for (auto in : m_pins[out].connections) {
+                    if (inRegion(in) && --pendingDrivers[memberIndex[m_pins[in].node]] == 0)
+                        order.emplace_back(m_pins[in].node);
+                }
+            }
+        }
+        if (order.size() < members.size())
+            throw std::runtime_error("The region has a feedback loop and cannot be collapsed");
+
+        // every output pin of the region gets a lane word, a member input reads
+        // either a table input (-1 - index) or the wired-or of internal pins
+        std::unordered_map<int, int> signalOf;
+        for (auto id : members) {
+            for (auto pin : m_nodes[id].outputs)
+                signalOf.emplace(pin, static_cast<int>(signalOf.size()));
+        }
+        std::vector<std::vector<std::vector<int>>> sources(members.size());
+        std::vector<SimTime> depths(signalOf.size(), 0);
+        SimTime delay = defaultDelay;
+        for (int i = 0; i < order.size(); i++) {
+            const auto &node = m_nodes[order[i]];
+            SimTime depth = 0;
+            for (auto pin : node.inputs) {
+                auto &source = sources[i].emplace_back();
+                if (auto it = tableInput.find(pin); it != tableInput.end()) {
+                    source.emplace_back(-1 - it->second);
+                    continue;
+                }
+                for (auto driver : m_pins[pin].connections) {
+                    source.emplace_back(signalOf[driver]);
+                    depth = std::max(depth, depths[signalOf[driver]]);
+                }
+            }
+            for (auto pin : node.outputs)
+                depths[signalOf[pin]] = depth + node.delay;
+        }
+        for (auto pin : outputs)
+            delay = std::max(delay, depths[signalOf[pin]]);
+
+        // 64 input combinations per pass, one per lane
+        const uint32_t combinations = 1u << inputs.size();
+        std::vector<uint32_t> table(combinations, 0);
+        std::vector<uint64_t> signals(signalOf.size());
+        uint64_t inputLanes[maxLookupInputs];
+        uint64_t gateInputs[Components::JComponentData::maxPorts], gateOutputs[Components::JComponentData::maxPorts];
+        for (uint32_t first = 0; first < combinations; first += 64) {
+            const uint32_t lanes = std::min<uint32_t>(64, combinations - first);
+            for (int i = 0; i < inputs.size(); i++) {
+                inputLanes[i] = 0;
+                for (uint32_t lane = 0; lane < lanes; lane++)
+                    inputLanes[i] |= uint64_t(((first + lane) >> i) & 1) << lane;
+            }
+
+            for (int i = 0; i < order.size(); i++) {
+                const auto &node = m_nodes[order[i]];
+                for (int k = 0; k < node.inputs.size(); k++) {
+                    uint64_t word = 0;
+                    for (auto source : sources[i][k])
+                        word |= source < 0 ? inputLanes[-1 - source] : signals[source];
+                    gateInputs[k] = word;
+                }
+                node.jcompData->evaluateLanes(gateInputs, gateOutputs);
+                for (int k = 0; k < node.outputs.size(); k++)
+                    signals[signalOf[node.outputs[k]]] = gateOutputs[k];
+            }
+
+            for (uint32_t lane = 0; lane < lanes; lane++) {
+                uint32_t entry = 0;
+                for (int k = 0; k < outputs.size(); k++)
+                    entry |= uint32_t((signals[signalOf[outputs[k]]] >> lane) & 1) << k;
+                table[first + lane] = entry;
+            }
+        }
+
+        int id = allocateNode();
+        auto &lut = m_nodes[id];
+        lut.kind = NodeKind::lookupTable;
+        lut.alive = true;
+        lut.inputs = inputs;
+        lut.outputs = outputs;
+        lut.table = std::move(table);
+        lut.members = members;
+        lut.delay = delay;
+        for (auto pin : inputs)
+            m_pins[pin].node = id;
+        for (auto pin : outputs)
+            m_pins[pin].node = id;
+
+        for (auto member : members) {
+            auto &node = m_nodes[member];
+            node.kind = NodeKind::collapsed;
+            node.collapsedInto = id;
+            for (auto pin : node.inputs) {
+                if (m_pins[pin].node != id)
+                    m_pins[pin].sampled = true;
+            }
+        }
+
+        m_revision++;
+        scheduleNode(id);
+        return id;
+    }
+
+    void Netlist::expand(int id) {
+        if (m_nodes[id].kind != NodeKind::lookupTable)
+            return;
+
+        auto members = std::move(m_nodes[id].members);
+        for (auto member : members) {
+            auto &node = m_nodes[member];
+            node.kind = NodeKind::jcomponent;
+            node.collapsedInto = invalidId;
+            for (auto pin : node.inputs) {
+                m_pins[pin].node = member;
+                m_pins[pin].sampled = false;
+            }
+            for (auto pin : node.outputs)
+                m_pins[pin].node = member;
+            scheduleNode(member);
+        }
+
+        m_nodes[id] = {};
+        m_freeNodes.emplace_back(id);
+        m_revision++;
+    }
+
+    void Netlist::expandPin(int pin) {
+        int node = m_pins[pin].node;
+        if (node == invalidId)
+            return;
+        if (m_nodes[node].kind == NodeKind::lookupTable)
+            expand(node);
+        else if (m_nodes[node].collapsedInto != invalidId)
+            expand(m_nodes[node].collapsedInto);
+    }
+
+    uint32_t Netlist::evaluateCombinational(const Node &node, uint32_t inputs) {
+        if (node.kind == NodeKind::lookupTable)
+            return node.table[inputs];
+        return node.jcompData->evaluate(inputs);
+    }
+
+    void Netlist::connect(const uuids::uuid &outputPin, const uuids::uuid &inputPin) {
+        int out = getOrAddPin(outputPin);
+        int in = getOrAddPin(inputPin);
+        expandPin(out);
+        expandPin(in);
+        m_pins[out].type = ComponentType::outputSlot;
+        m_pins[in].type = ComponentType::inputSlot;
+
+        auto &fanout = m_pins[out].connections;
+        if (std::ranges::find(fanout, in) != fanout.end())
+            return;
+        fanout.emplace_back(in);
+        m_pins[in].connections.emplace_back(out);
+        if (m_pinStates[out] == DigitalState::high)
+            m_highDrivers[in]++;
+        m_revision++;
+        schedulePin(in);
+    }
+
+    void Netlist::disconnect(const uuids::uuid &outputPin, const uuids::uuid &inputPin) {
+        int out = getPinId(outputPin);
+        int in = getPinId(inputPin);
+        if (out == invalidId || in == invalidId)
+            return;
+        expandPin(out);
+        expandPin(in);
+
+        auto &fanout = m_pins[out].connections;
+        auto it = std::remove(fanout.begin(), fanout.end(), in);
+        if (it == fanout.end())
+            return;
+        fanout.erase(it, fanout.end());
+        auto &drivers = m_pins[in].connections;
+        drivers.erase(std::remove(drivers.begin(), drivers.end(), out), drivers.end());
+        if (m_pinStates[out] == DigitalState::high)
+            m_highDrivers[in]--;
+        m_revision++;
+        schedulePin(in);
+    }
+
+    DigitalState Netlist::getPinState(int pin) const {
+        return static_cast<DigitalState>(m_pinStates[pin]);
+    }
+
+    void Netlist::drivePin(int pin, DigitalState state) {
+        if (m_pinStates[pin] == state)
+            return;
+        m_pinStates[pin] = state;
+        if (m_pins[pin].traced)
+            tracePin(pin);
+
+        const uint32_t delta = state == DigitalState::high ? 1 : uint32_t(-1);
+        for (auto conn : m_pins[pin].connections)
+            m_highDrivers[conn] += delta;
+        propagate(pin);
+    }
+
+    uint64_t Netlist::getPinWord(int pin) const {
+        return m_pins[pin].width > 1 ? m_pinWords[pin] : m_pinStates[pin];
+    }
+
+    const std::vector<uint64_t> &Netlist::getPinWords() const {
+        return m_pinWords;
+    }
+
+    void Netlist::driveWord(int pin, uint64_t word) {
+        word &= widthMask(m_pins[pin].width);
+        if (m_pinWords[pin] == word)
+            return;
+        m_pinWords[pin] = word;
+        if (m_pins[pin].traced)
+            tracePin(pin);
+
+        // single bit pins reading the bus see it high while any bit is set
+        const auto state = word != 0 ? DigitalState::high : DigitalState::low;
+        if (m_pinStates[pin] != state) {
+            m_pinStates[pin] = state;
+            const uint32_t delta = state == DigitalState::high ? 1 : uint32_t(-1);
+            for (auto conn : m_pins[pin].connections)
+                m_highDrivers[conn] += delta;
+        }
+        propagate(pin);
+    }
+
+    void Netlist::setTraceRecorder(TraceRecorder *recorder) {
+        m_trace = recorder;
+    }
+
+    void Netlist::setDeferredEvaluator(DeferredEvaluator *evaluator) {
+        m_deferred = evaluator;
+        // a new evaluator starts with a pass over everything it takes over
+        m_deferredPending = evaluator != nullptr;
+    }
+
+    void Netlist::setPinTraced(int pin, bool traced) {
+        // signals can outlive their pin when the project changes
+        if (pin < 0 || pin >= m_pins.size() || !m_pins[pin].alive)
+            return;
+        m_pins[pin].traced = traced;
+        // the trace of the pin starts from its current state
+        if (traced)
+            tracePin(pin);
+    }
+
+    void Netlist::tracePin(int pin) {
+        if (m_trace != nullptr)
+            m_trace->record(m_wheel.getTime(), pin, getPinWord(pin));
+    }
+
+    void Netlist::propagate(int pin) {
+        for (auto conn : m_pins[pin].connections) {
+            schedulePin(conn);
+        }
+    }
+
+    void Netlist::schedulePin(int pin) {
+        m_nextQueue.push_back({pin, SimEventType::pin, DigitalState::low});
+        if (m_trackChanges && m_deferred == nullptr)
+            m_changes.pins.push_back(pin);
+    }
+
+    void Netlist::scheduleOutput(int pin, DigitalState state, SimTime delay) {
+        cancelPendingOutput(pin);
+        if (m_pinStates[pin] == state)
+            return;
+        m_pendingEvents[pin] = m_wheel.schedule(m_wheel.getTime() + delay, {pin, SimEventType::pin, state});
+    }
+
+    void Netlist::scheduleWord(int pin, uint64_t word, SimTime delay) {
+        cancelPendingOutput(pin);
+        if (m_pinWords[pin] == word)
+            return;
+        m_pendingWords[pin] = word;
+        m_pendingEvents[pin] = m_wheel.schedule(m_wheel.getTime() + delay, {pin, SimEventType::pin, DigitalState::low});
+    }
+
+    void Netlist::scheduleNode(int node, SimEventType type) {
+        if (m_trackChanges && m_deferred != nullptr) {
+            // the evaluator finds the node in the log
+            if (type == SimEventType::node && m_deferred->defers(node)) {
+                m_changes.nodes.push_back(node);
+                m_deferredPending = true;
+                return;
+            }
+        } else if (m_trackChanges) {
+            m_changes.nodes.push_back(node);
+        }
+        m_nextQueue.push_back({node, type, DigitalState::low});
+    }
+
+    void Netlist::trackChanges(bool track) {
+        m_trackChanges = track;
+        m_changes.pins.clear();
+        m_changes.nodes.clear();
+    }
+
+    void Netlist::takeChanges(Changes &changes) {
+        changes.pins.clear();
+        changes.nodes.clear();
+        std::swap(changes, m_changes);
+    }
+
+    void Netlist::refresh() {
+        for (int i = 0; i < m_nodes.size(); i++) {
+            if (m_nodes[i].alive && m_nodes[i].kind == NodeKind::inputProbe)
+                scheduleNode(i, SimEventType::refresh);
+        }
+    }
+
+    void Netlist::simulate() {
+        updateLoops();
+        // zero delay work left by edits since the last tick
+        settle();
+
+        m_wheel.advance(m_dueEvents);
+        m_stats.events += m_dueEvents.size();
+        for (const auto &ev : m_dueEvents) {
+            if (ev.type == SimEventType::pin) {
+                m_pendingEvents[ev.target] = TimingWheel::invalidHandle;
+                if (m_pins[ev.target].width > 1)
+                    driveWord(ev.target, m_pendingWords[ev.target]);
+                else
+                    drivePin(ev.target, ev.state);
+                if (int node = m_pins[ev.target].node; node != invalidId && m_nodes[node].loop != invalidId)
+                    countLoopChange(m_nodes[node].loop);
+                continue;
+            }
+
+            // clock edge
+            auto &node = m_nodes[ev.target];
+            node.clockEvent = TimingWheel::invalidHandle;
+            node.clockEdges++;
+            for (auto out : node.outputs)
+                drivePin(out, !getPinState(out));
+            scheduleClockEdge(ev.target);
+        }
+        m_dueEvents.clear();
+
+        settle();
+    }
+
+    void Netlist::settle() {
+        settleQueue();
+        // the evaluator wakes the nodes it does not defer and they may wake
+        // deferred ones again
+        for (int round = 0; round < maxDeltaCycles && m_deferred != nullptr && m_deferredPending; round++) {
+            m_deferredPending = false;
+            m_deferred->evaluate();
+            settleQueue();
+        }
+    }
+
+    void Netlist::settleQueue() {
+        // node outputs go through the wheel, so the rounds end once the
+        // driven input pins and their nodes have been processed
+        for (int round = 0; round < maxDeltaCycles && !m_nextQueue.empty(); round++) {
+            std::swap(m_currentQueue, m_nextQueue);
+            m_nextQueue.clear();
+            m_step++;
+
+            for (const auto &el : m_currentQueue) {
+                if (el.type == SimEventType::pin) {
+                    if (!m_pins[el.target].alive || m_pinStamps[el.target] == m_step)
+                        continue;
+                    m_pinStamps[el.target] = m_step;
+                    updateInputPin(el.target);
+                } else {
+                    if (!m_nodes[el.target].alive || m_nodeStamps[el.target] == m_step)
+                        continue;
+                    m_nodeStamps[el.target] = m_step;
+                    m_stats.evaluations++;
+                    evaluateNode(el.target, el.type == SimEventType::refresh);
+                }
+            }
+            m_currentQueue.clear();
+        }
+    }
+
+    void Netlist::runFor(SimTime ticks) {
+        runUntil(getTime() + ticks);
+    }
+
+    void Netlist::runUntil(SimTime time) {
+        while (getTime() < time) {
+            settle();
+            // nothing can happen before the next event, so there is no point
+            // in walking the empty ticks one by one
+            auto idleUntil = std::min(m_wheel.getIdleUntil(), time);
+            if (idleUntil > getTime() && m_nextQueue.empty()) {
+                m_wheel.skipTo(idleUntil);
+                continue;
+            }
+            simulate();
+        }
+    }
+
+    bool Netlist::isIdle() const {
+        return m_nextQueue.empty() && m_wheel.size() == 0 && !(m_deferred != nullptr && m_deferredPending);
+    }
+
+    SimTime Netlist::getTime() const {
+        return m_wheel.getTime();
+    }
+
+    const Netlist::Stats &Netlist::getStats() const {
+        return m_stats;
+    }
+
+    void Netlist::resetStats() {
+        m_stats = {};
+    }
+
+    DigitalState Netlist::resolveDrivers(int pin) const {
+        return m_highDrivers[pin] > 0 ? DigitalState::high : DigitalState::low;
+    }
+
+    void Netlist::setPinState(int pin, DigitalState state) {
+        if (m_pinStates[pin] == state)
+            return;
+        m_pinStates[pin] = state;
+        if (m_pins[pin].traced)
+            tracePin(pin);
+        if (m_pins[pin].type != ComponentType::outputSlot)
+            return;
+
+        // outputs of the same level can share a net, so the counters are
+        // updated atomically
+        const uint32_t delta = state == DigitalState::high ? 1 : uint32_t(-1);
+        for (auto conn : m_pins[pin].connections)
+            std::atomic_ref(m_highDrivers[conn]).fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void Netlist::cancelPendingOutput(int pin) {
+        auto &pending = m_pendingEvents[pin];
+        if (pending == TimingWheel::invalidHandle)
+            return;
+        m_wheel.cancel(pending);
+        pending = TimingWheel::invalidHandle;
+    }
+
+    uint64_t Netlist::getRevision() const {
+        return m_revision;
+    }
+
+    const std::vector<Netlist::Loop> &Netlist::getLoops() const {
+        return m_loops;
+    }
+
+    void Netlist::setFreezeOscillations(bool freeze) {
+        m_freezeOscillations = freeze;
+        for (int id = 0; id < m_loops.size(); id++) {
+            auto &loop = m_loops[id];
+            if (freeze && loop.oscillating && !loop.frozen) {
+                freezeLoop(id);
+            } else if (!freeze && loop.frozen) {
+                loop.frozen = false;
+                loop.changes = 0;
+                for (auto node : loop.nodes)
+                    scheduleNode(node);
+            }
+        }
+        m_oscillationRevision++;
+    }
+
+    bool Netlist::getFreezeOscillations() const {
+        return m_freezeOscillations;
+    }
+
+    void Netlist::releaseLoops() {
+        for (auto &loop : m_loops) {
+            if (loop.frozen) {
+                for (auto node : loop.nodes)
+                    scheduleNode(node);
+            }
+            loop.changes = 0;
+            loop.oscillating = false;
+            loop.frozen = false;
+        }
+        m_oscillationRevision++;
+    }
+
+    uint64_t Netlist::getOscillationRevision() const {
+        return m_oscillationRevision;
+    }
+
+    void Netlist::updateLoops() {
+        if (m_loopRevision == m_revision)
+            return;
+        m_loopRevision = m_revision;
+
+        // an edit can break or change any loop, they all start over
+        for (auto &loop : m_loops) {
+            if (loop.oscillating)
+                m_oscillationRevision++;
+            for (auto node : loop.nodes) {
+                if (node >= m_nodes.size())
+                    continue;
+                m_nodes[node].loop = invalidId;
+                if (loop.frozen && m_nodes[node].alive)
+                    scheduleNode(node);
+            }
+        }
+
+        m_loops.clear();
+        for (auto &nodes : Levelizer::findLoops(*this)) {
+            for (auto node : nodes)
+                m_nodes[node].loop = static_cast<int>(m_loops.size());
+            m_loops.push_back({std::move(nodes)});
+        }
+
+        m_loopInputs.assign(m_pins.size(), 0);
+        for (auto &loop : m_loops) {
+            for (auto node : loop.nodes) {
+                for (auto pin : m_nodes[node].inputs) {
+                    for (auto driver : m_pins[pin].connections) {
+                        int driverNode = m_pins[driver].node;
+                        if (driverNode == invalidId || m_nodes[driverNode].loop != m_nodes[node].loop)
+                            m_loopInputs[pin] = 1;
+                    }
+                }
+            }
+        }
+    }
+
+    void Netlist::countLoopChange(int id) {
+        auto &loop = m_loops[id];
+        if (loop.oscillating || ++loop.changes <= maxLoopChanges * loop.nodes.size())
+            return;
+        loop.oscillating = true;
+        m_oscillationRevision++;
+        if (m_freezeOscillations)
+            freezeLoop(id);
+    }
+
+    void Netlist::freezeLoop(int id) {
+        auto &loop = m_loops[id];
+        loop.frozen = true;
+        for (auto node : loop.nodes) {
+            for (auto pin : m_nodes[node].outputs)
+                cancelPendingOutput(pin);
+        }
+    }
+
+    void Netlist::updateInputPin(int pin) {
+        if (m_pins[pin].width > 1) {
+            uint64_t word = 0;
+            for (auto driver : m_pins[pin].connections)
+                word |= getPinWord(driver);
+            word &= widthMask(m_pins[pin].width);
+            if (m_pinWords[pin] == word)
+                return;
+            m_pinWords[pin] = word;
+            m_pinStates[pin] = word != 0 ? DigitalState::high : DigitalState::low;
+        } else {
+            auto state = resolveDrivers(pin);
+            if (m_pinStates[pin] == state)
+                return;
+            m_pinStates[pin] = state;
+        }
+        if (m_pins[pin].traced)
+            tracePin(pin);
+
+        // edge triggered nodes read their data inputs when the clock wakes
+        // them, so those inputs changing alone costs nothing
+        int node = m_pins[pin].node;
+        // a loop fed a new value from outside gets to settle again
+        if (node != invalidId && pin < m_loopInputs.size() && m_loopInputs[pin] && m_nodes[node].loop != invalidId) {
+            auto &loop = m_loops[m_nodes[node].loop];
+            loop.changes = 0;
+            if (loop.oscillating && !loop.frozen) {
+                loop.oscillating = false;
+                m_oscillationRevision++;
+            }
+        }
+        if (node == invalidId || m_pins[pin].sampled)
+            return;
+        scheduleNode(node);
+    }
+
+    void Netlist::evaluateNode(int id, bool refresh) {
+        const auto &node = m_nodes[id];
+        if (node.loop != invalidId && m_loops[node.loop].frozen)
+            return;
+        switch (node.kind) {
+        case NodeKind::jcomponent:
+        case NodeKind::lookupTable: {
+            uint32_t inputs = 0;
+            for (int i = 0; i < node.inputs.size(); i++) {
+                if (m_pinStates[node.inputs[i]] == DigitalState::high)
+                    inputs |= 1u << i;
+            }
+
+            auto outputs = evaluateCombinational(node, inputs);
+            for (int i = 0; i < node.outputs.size(); i++) {
+                scheduleOutput(node.outputs[i], (outputs >> i) & 1 ? DigitalState::high : DigitalState::low, node.delay);
+            }
+        } break;
+        case NodeKind::inputProbe:
+        case NodeKind::clock: {
+            if (!refresh)
+                break;
+            for (auto out : node.outputs)
+                propagate(out);
+        } break;
+        case NodeKind::jkFlipFlop:
+        case NodeKind::dFlipFlop:
+            evaluateFlipFlop(id);
+            break;
+        case NodeKind::dRegister:
+        case NodeKind::counter:
+        case NodeKind::shiftRegister:
+        case NodeKind::registerFile:
+            evaluateRegister(id);
+            break;
+        case NodeKind::splitter:
+        case NodeKind::merger:
+        case NodeKind::wordComponent:
+            evaluateBus(id);
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool Netlist::takeClockEdge(Node &node) {
+        if (node.clockPin == invalidId)
+            return false;
+        const auto clock = getPinState(node.clockPin);
+        const bool edge = clock != node.lastClock &&
+                          (clock == DigitalState::high) == (node.clockEdge == ClockEdge::rising);
+        node.lastClock = clock;
+        return edge;
+    }
+
+    void Netlist::evaluateFlipFlop(int id) {
+        // only the clock pin schedules the node, it acts on the selected edge
+        auto &node = m_nodes[id];
+        if (!takeClockEdge(node))
+            return;
+        // a pin of the flip flop was removed ahead of the flip flop itself
+        const size_t inputCount = node.kind == NodeKind::dFlipFlop ? 1 : 2;
+        if (node.inputs.size() < inputCount || node.outputs.size() < 2)
+            return;
+
+        // the inputs are sampled at the edge, the outputs follow after the
+        // delay, like a master slave pair, so a flip flop feeding another one
+        // on the same clock is read before it changes
+        auto qState = getPinState(node.outputs[0]);
+        if (node.kind == NodeKind::dFlipFlop) {
+            qState = getPinState(node.inputs[0]);
+        } else {
+            auto j = getPinState(node.inputs[0]);
+            auto k = getPinState(node.inputs[1]);
+            if (j == DigitalState::high && k == DigitalState::high) {
+                qState = !qState;
+            } else if (j != k) {
+                qState = j;
+            }
+        }
+
+        scheduleOutput(node.outputs[0], qState, node.delay);
+        scheduleOutput(node.outputs[1], !qState, node.delay);
+    }
+
+    void Netlist::evaluateBus(int id) {
+        const auto &node = m_nodes[id];
+        switch (node.kind) {
+        case NodeKind::splitter: {
+            const uint64_t word = node.inputs.empty() ? 0 : getPinWord(node.inputs[0]);
+            for (int i = 0; i < node.outputs.size(); i++)
+                drivePin(node.outputs[i], (word >> i) & 1 ? DigitalState::high : DigitalState::low);
+        } break;
+        case NodeKind::merger: {
+            uint64_t word = 0;
+            for (int i = 0; i < node.inputs.size(); i++) {
+                if (m_pinStates[node.inputs[i]] == DigitalState::high)
+                    word |= uint64_t(1) << i;
+            }
+            if (!node.outputs.empty())
+                driveWord(node.outputs[0], word);
+        } break;
+        case NodeKind::wordComponent: {
+            uint64_t inputs[Components::JComponentData::maxPorts] = {};
+            uint64_t outputs[Components::JComponentData::maxPorts] = {};
+            for (int i = 0; i < node.inputs.size(); i++)
+                inputs[i] = getPinWord(node.inputs[i]);
+            node.jcompData->evaluateWords(inputs, outputs);
+
+            for (int i = 0; i < node.outputs.size(); i++) {
+                const int pin = node.outputs[i];
+                if (m_pins[pin].width > 1)
+                    scheduleWord(pin, outputs[i], node.delay);
+                else
+                    scheduleOutput(pin, outputs[i] & 1 ? DigitalState::high : DigitalState::low, node.delay);
+            }
+        } break;
+        default:
+            break;
+        }
+    }
+
+    void Netlist::evaluateRegister(int id) {
+        // one evaluation per edge updates the whole word
+        auto &node = m_nodes[id];
+        const bool edge = takeClockEdge(node);
+        const size_t width = std::min<size_t>(node.outputs.size(), 64);
+        const uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+
+        auto readBits = [&](size_t first, size_t count) {
+            uint64_t word = 0;
+            for (size_t i = 0; i < count && i < 64 && first + i < node.inputs.size(); i++) {
+                if (m_pinStates[node.inputs[first + i]] == DigitalState::high)
+                    word |= uint64_t(1) << i;
+            }
+            return word;
+        };
+        auto readBit = [&](size_t index) {
+            return index < node.inputs.size() && m_pinStates[node.inputs[index]] == DigitalState::high;
+        };
+
+        auto &state = node.words;
+        size_t shown = 0;
+        switch (node.kind) {
+        case NodeKind::dRegister:
+            if (!edge)
+                return;
+            state[0] = readBits(0, std::min(width, node.inputs.size()));
+            break;
+        case NodeKind::counter:
+            if (!edge)
+                return;
+            if (readBit(2))
+                state[0] = 0;
+            else if (readBit(0))
+                state[0] = (readBit(1) ? state[0] - 1 : state[0] + 1) & mask;
+            break;
+        case NodeKind::shiftRegister:
+            if (!edge)
+                return;
+            if (readBit(1))
+                state[0] = ((state[0] << 1) | uint64_t(readBit(0))) & mask;
+            break;
+        case NodeKind::registerFile: {
+            // the address bits follow from the pin counts, which drop while
+            // the pins of a resized register file are removed
+            const size_t addressBits = getAddressBits(node);
+            const size_t written = readBits(width, addressBits);
+            if (edge && readBit(width + addressBits) && written < state.size())
+                state[written] = readBits(0, width);
+            shown = readBits(width + addressBits + 1, addressBits);
+            if (shown >= state.size())
+                return;
+        } break;
+        default:
+            return;
+        }
+
+        for (size_t i = 0; i < width; i++) {
+            auto bit = (state[shown] >> i) & 1 ? DigitalState::high : DigitalState::low;
+            scheduleOutput(node.outputs[i], bit, node.delay);
+        }
+    }
+
+    void Netlist::clearQueue() {
+        m_currentQueue.clear();
+        m_nextQueue.clear();
+        m_wheel.clear();
+        std::ranges::fill(m_pendingEvents, TimingWheel::invalidHandle);
+
+        // running clocks keep going from the current time
+        for (int i = 0; i < m_nodes.size(); i++) {
+            auto &node = m_nodes[i];
+            node.clockEvent = TimingWheel::invalidHandle;
+            if (node.clockHalfPeriod > 0.0) {
+                node.clockStart = m_wheel.getTime();
+                node.clockEdges = 0;
+                scheduleClockEdge(i);
+            }
+        }
+    }
+
+    void Netlist::clear() {
+        m_pins.clear();
+        m_pinStates.clear();
+        m_highDrivers.clear();
+        m_pinWords.clear();
+        m_pendingWords.clear();
+        m_pinStamps.clear();
+        m_pendingEvents.clear();
+        m_nodes.clear();
+        m_nodeStamps.clear();
+        m_freePins.clear();
+        m_freeNodes.clear();
+        m_pinIds.clear();
+        m_nodeIds.clear();
+        m_changes.pins.clear();
+        m_changes.nodes.clear();
+        m_loops.clear();
+        m_loopInputs.clear();
+        m_revision++;
+        clearQueue();
+    }
+
+    size_t Netlist::Snapshot::getMemoryUsage() const {
+        size_t bytes = sizeof(Snapshot) + pinStates.capacity() * sizeof(uint64_t) +
+                       pinWords.capacity() * sizeof(pinWords[0]) +
+                       pendingOutputs.capacity() * sizeof(PendingOutput) +
+                       nodeStates.capacity() * sizeof(NodeState);
+        for (auto &state : nodeStates)
+            bytes += state.words.capacity() * sizeof(uint64_t);
+        return bytes;
+    }
+
+    Netlist::Snapshot Netlist::takeSnapshot() const {
+        Snapshot snapshot;
+        snapshot.time = m_wheel.getTime();
+        snapshot.revision = m_revision;
+
+        snapshot.pinStates.assign((m_pins.size() + 63) / 64, 0);
+        for (int pin = 0; pin < m_pins.size(); pin++) {
+            if (m_pinStates[pin] == DigitalState::high)
+                snapshot.pinStates[pin / 64] |= uint64_t(1) << (pin % 64);
+            if (m_pins[pin].width > 1 && m_pinWords[pin] != 0)
+                snapshot.pinWords.emplace_back(pin, m_pinWords[pin]);
+
+            if (const int handle = m_pendingEvents[pin]; handle != TimingWheel::invalidHandle) {
+                const uint64_t value = m_pins[pin].width > 1 ? m_pendingWords[pin] : static_cast<uint64_t>(m_wheel.getEvent(handle).state);
+                snapshot.pendingOutputs.push_back({pin, m_wheel.getEventTime(handle), value});
+            }
+        }
+
+        for (int id = 0; id < m_nodes.size(); id++) {
+            const auto &node = m_nodes[id];
+            if (!node.alive || (node.kind != NodeKind::clock && !isEdgeTriggered(node.kind) && node.words.empty()))
+                continue;
+            snapshot.nodeStates.push_back({id, node.lastClock, node.clockHalfPeriod, node.clockStart, node.clockEdges, node.words});
+        }
+        return snapshot;
+    }
+
+    void Netlist::restoreSnapshot(const Snapshot &snapshot) {
+        if (snapshot.revision != m_revision)
+            throw std::runtime_error("The circuit was edited after the snapshot was taken");
+
+        m_currentQueue.clear();
+        m_nextQueue.clear();
+        m_wheel.reset(snapshot.time);
+        std::ranges::fill(m_pendingEvents, TimingWheel::invalidHandle);
+
+        for (int pin = 0; pin < m_pins.size(); pin++)
+            m_pinStates[pin] = (snapshot.pinStates[pin / 64] >> (pin % 64)) & 1 ? DigitalState::high : DigitalState::low;
+        std::ranges::fill(m_pinWords, 0);
+        for (auto &[pin, word] : snapshot.pinWords)
+            m_pinWords[pin] = word;
+
+        // the driver counters follow from the output states
+        std::ranges::fill(m_highDrivers, 0);
+        for (int pin = 0; pin < m_pins.size(); pin++) {
+            if (!m_pins[pin].alive || m_pins[pin].type != ComponentType::outputSlot || m_pinStates[pin] != DigitalState::high)
+                continue;
+            for (auto conn : m_pins[pin].connections)
+                m_highDrivers[conn]++;
+        }
+
+        for (auto &node : m_nodes)
+            node.clockEvent = TimingWheel::invalidHandle;
+        for (auto &state : snapshot.nodeStates) {
+            auto &node = m_nodes[state.node];
+            node.lastClock = state.lastClock;
+            node.clockHalfPeriod = state.clockHalfPeriod;
+            node.clockStart = state.clockStart;
+            node.clockEdges = state.clockEdges;
+            node.words = state.words;
+            if (node.clockHalfPeriod > 0.0)
+                scheduleClockEdge(state.node);
+        }
+
+        for (auto &pending : snapshot.pendingOutputs) {
+            m_pendingWords[pending.pin] = pending.value;
+            const auto state = pending.value & 1 ? DigitalState::high : DigitalState::low;
+            m_pendingEvents[pending.pin] = m_wheel.schedule(pending.time, {pending.pin, SimEventType::pin, state});
+        }
+
+        // every net may differ from the last pass, log all nodes as changed
+        if (m_trackChanges) {
+            m_changes.pins.clear();
+            m_changes.nodes.clear();
+            for (int id = 0; id < m_nodes.size(); id++) {
+                if (m_nodes[id].alive)
+                    m_changes.nodes.push_back(id);
+            }
+            m_deferredPending = m_deferred != nullptr;
+        }
+    }
+
+    const std::vector<Netlist::Pin> &Netlist::getPins() const {
+        return m_pins;
+    }
+
+    const std::vector<uint8_t> &Netlist::getPinStates() const {
+        return m_pinStates;
+    }
+
+    const std::vector<Netlist::Node> &Netlist::getNodes() const {
+        return m_nodes;
+    }
+} // namespace Bess::Simulator
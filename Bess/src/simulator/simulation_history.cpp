@@ -0,0 +1,108 @@
+#include "simulator/simulation_history.h"
+
+#include <algorithm>
+
+namespace Bess::Simulator {
+    SimulationHistory::SimulationHistory(SimTime interval, size_t memoryBudget)
+        : m_interval(std::max<SimTime>(interval, 1)), m_memoryBudget(memoryBudget) {
+    }
+
+    void SimulationHistory::capture(const Netlist &netlist) {
+        const SimTime time = netlist.getTime();
+        if (!m_snapshots.empty()) {
+            const auto &latest = m_snapshots.back();
+            if (latest.revision != netlist.getRevision() || time < latest.time)
+                clear();
+            else if (time - latest.time < m_interval)
+                return;
+        }
+
+        m_snapshots.emplace_back(netlist.takeSnapshot());
+        m_memoryUsage += m_snapshots.back().getMemoryUsage();
+
+        // always keep the newest snapshot, even on its own over the budget
+        while (m_snapshots.size() > 1 && m_memoryUsage > m_memoryBudget) {
+            m_memoryUsage -= m_snapshots.front().getMemoryUsage();
+            m_snapshots.pop_front();
+        }
+        const SimTime oldest = m_snapshots.front().time;
+        while (!m_inputs.empty() && m_inputs.front().time < oldest)
+            m_inputs.pop_front();
+        updateBounds();
+    }
+
+    void SimulationHistory::recordInput(SimTime time, int pin, DigitalState state) {
+        if (m_snapshots.empty())
+            return;
+        m_inputs.push_back({time, pin, state});
+    }
+
+    bool SimulationHistory::rewind(Netlist &netlist, SimTime time) {
+        auto snapshot = std::ranges::find_if(m_snapshots.rbegin(), m_snapshots.rend(),
+                                             [&](const Netlist::Snapshot &snapshot) { return snapshot.time <= time; });
+        if (snapshot == m_snapshots.rend())
+            return false;
+        if (snapshot->revision != netlist.getRevision()) {
+            clear();
+            return false;
+        }
+
+        netlist.restoreSnapshot(*snapshot);
+        for (auto &input : m_inputs) {
+            if (input.time < snapshot->time)
+                continue;
+            if (input.time > time)
+                break;
+            netlist.runUntil(input.time);
+            netlist.drivePin(input.pin, input.state);
+        }
+        netlist.runUntil(time);
+
+        // the snapshots and inputs after the target belong to a discarded future
+        const size_t keep = m_snapshots.rend() - snapshot;
+        while (m_snapshots.size() > keep) {
+            m_memoryUsage -= m_snapshots.back().getMemoryUsage();
+            m_snapshots.pop_back();
+        }
+        while (!m_inputs.empty() && m_inputs.back().time > time)
+            m_inputs.pop_back();
+        updateBounds();
+        return true;
+    }
+
+    void SimulationHistory::clear() {
+        m_snapshots.clear();
+        m_inputs.clear();
+        m_memoryUsage = 0;
+        updateBounds();
+    }
+
+    void SimulationHistory::setInterval(SimTime interval) {
+        m_interval = std::max<SimTime>(interval, 1);
+    }
+
+    SimTime SimulationHistory::getInterval() const {
+        return m_interval;
+    }
+
+    SimTime SimulationHistory::getOldestTime() const {
+        return m_oldestTime.load(std::memory_order_relaxed);
+    }
+
+    SimTime SimulationHistory::getLatestTime() const {
+        return m_latestTime.load(std::memory_order_relaxed);
+    }
+
+    size_t SimulationHistory::getMemoryUsage() const {
+        return m_memoryUsage;
+    }
+
+    size_t SimulationHistory::getSnapshotCount() const {
+        return m_snapshots.size();
+    }
+
+    void SimulationHistory::updateBounds() {
+        m_oldestTime.store(m_snapshots.empty() ? 0 : m_snapshots.front().time, std::memory_order_relaxed);
+        m_latestTime.store(m_snapshots.empty() ? 0 : m_snapshots.back().time, std::memory_order_relaxed);
+    }
+} // namespace Bess::Simulator
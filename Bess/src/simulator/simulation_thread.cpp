@@ -0,0 +1,252 @@
+#include "simulator/simulation_thread.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Bess::Simulator {
+    using Clock = std::chrono::steady_clock;
+
+    SimulationThread::SimulationThread(Netlist &netlist) : m_netlist(netlist) {
+    }
+
+    SimulationThread::~SimulationThread() {
+        stop();
+    }
+
+    void SimulationThread::start() {
+        if (m_running)
+            return;
+        m_running = true;
+        m_thread = std::thread(&SimulationThread::run, this);
+    }
+
+    void SimulationThread::stop() {
+        if (!m_running)
+            return;
+        {
+            std::lock_guard lock(m_commandsMutex);
+            m_running = false;
+        }
+        m_wake.notify_all();
+        m_thread.join();
+    }
+
+    uint64_t SimulationThread::push(Command command) {
+        uint64_t sequence;
+        {
+            std::lock_guard lock(m_commandsMutex);
+            m_commands.emplace_back(std::move(command));
+            sequence = ++m_pushedCommands;
+        }
+        m_wake.notify_all();
+        return sequence;
+    }
+
+    void SimulationThread::step(uint64_t ticks) {
+        std::lock_guard lock(m_netlistMutex);
+        applyCommands();
+        runTicks(ticks);
+        publish();
+    }
+
+    void SimulationThread::applyCommands() {
+        {
+            std::lock_guard lock(m_commandsMutex);
+            if (m_commands.empty())
+                return;
+            std::swap(m_commands, m_pendingCommands);
+            m_appliedCommands = m_pushedCommands;
+        }
+
+        for (auto &command : m_pendingCommands)
+            command(m_netlist);
+        m_pendingCommands.clear();
+        m_dirty = true;
+    }
+
+    void SimulationThread::setPaused(bool paused) {
+        m_paused = paused;
+        m_wake.notify_all();
+    }
+
+    bool SimulationThread::isPaused() const {
+        return m_paused;
+    }
+
+    void SimulationThread::setTickRate(double rate) {
+        m_tickRate = std::max(rate, 0.0);
+        m_wake.notify_all();
+    }
+
+    double SimulationThread::getTickRate() const {
+        return m_tickRate;
+    }
+
+    double SimulationThread::getAchievedTickRate() const {
+        return m_achievedTickRate;
+    }
+
+    void SimulationThread::setLevelized(bool enabled, size_t threadCount) {
+        std::lock_guard lock(m_netlistMutex);
+        // the old simulator stops the change log when it goes away, so it has
+        // to go before the new one starts it
+        m_levelized = nullptr;
+        if (enabled)
+            m_levelized = std::make_unique<LevelizedSimulator>(m_netlist, threadCount);
+    }
+
+    void SimulationThread::setHistory(SimulationHistory *history) {
+        std::lock_guard lock(m_netlistMutex);
+        m_history = history;
+    }
+
+    bool SimulationThread::acquireSnapshot() {
+        return m_snapshot.acquire();
+    }
+
+    const std::vector<uint8_t> &SimulationThread::getSnapshot() const {
+        return m_snapshot.getFrontBuffer();
+    }
+
+    void SimulationThread::runTicks(uint64_t ticks) {
+        if (ticks == 0)
+            return;
+        m_netlist.runFor(ticks);
+        if (m_history)
+            m_history->capture(m_netlist);
+        m_dirty = true;
+    }
+
+    SimTime SimulationThread::getTime() const {
+        return m_time;
+    }
+
+    void SimulationThread::publish() {
+        const auto &states = m_netlist.getPinStates();
+        m_snapshot.getBackBuffer().assign(states.begin(), states.end());
+        m_snapshot.publish();
+        m_time = m_netlist.getTime();
+        m_dirty = false;
+
+        {
+            std::lock_guard lock(m_pinIdsMutex);
+            if (m_netlist.getRevision() != m_pinIdsRevision) {
+                m_pinIds = m_netlist.getPinIds();
+                m_pinIdsRevision = m_netlist.getRevision();
+            }
+            m_publishedCommands = m_appliedCommands;
+        }
+
+        if (m_netlist.getOscillationRevision() == m_oscillationRevision)
+            return;
+        std::vector<LoopReport> loops;
+        for (auto &loop : m_netlist.getLoops()) {
+            if (!loop.oscillating)
+                continue;
+            auto &report = loops.emplace_back(LoopReport{{}, loop.frozen});
+            for (auto node : loop.nodes)
+                report.nodes.emplace_back(m_netlist.getNodes()[node].uid);
+        }
+        std::lock_guard lock(m_oscillationMutex);
+        m_oscillatingLoops = std::move(loops);
+        m_oscillationRevision = m_netlist.getOscillationRevision();
+    }
+
+    int SimulationThread::getPinId(const uuids::uuid &uid, uint64_t command) const {
+        std::lock_guard lock(m_pinIdsMutex);
+        if (m_publishedCommands < command)
+            return Netlist::invalidId;
+        auto it = m_pinIds.find(uid);
+        return it == m_pinIds.end() ? Netlist::invalidId : it->second;
+    }
+
+    std::vector<SimulationThread::LoopReport> SimulationThread::getOscillatingLoops() const {
+        std::lock_guard lock(m_oscillationMutex);
+        return m_oscillatingLoops;
+    }
+
+    uint64_t SimulationThread::getOscillationRevision() const {
+        return m_oscillationRevision;
+    }
+
+    void SimulationThread::run() {
+        const auto maxBatch = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(maxBatchSeconds));
+
+        auto prevTime = Clock::now();
+        auto rateWindowStart = prevTime;
+        uint64_t windowTicks = 0;
+        // ticks due at the configured rate that did not run yet
+        double owedTicks = 0.0;
+        // Idle stretches cost nothing while a busy circuit can take long per
+        // tick, so the slice grows or shrinks to keep the batches short.
+        uint64_t slice = minSlice;
+        auto runSlice = [&](uint64_t ticks) {
+            const auto sliceStart = Clock::now();
+            runTicks(ticks);
+            windowTicks += ticks;
+
+            const auto sliceTime = Clock::now() - sliceStart;
+            if (ticks == slice && sliceTime < maxBatch / 16)
+                slice = std::min(slice * 2, maxSlice);
+            else if (sliceTime > maxBatch / 2)
+                slice = std::max(slice / 2, minSlice);
+        };
+
+        while (m_running) {
+            const auto now = Clock::now();
+            const double elapsed = std::chrono::duration<double>(now - prevTime).count();
+            prevTime = now;
+
+            const double rate = m_tickRate;
+            const bool paused = m_paused;
+            bool idle = false;
+
+            {
+                std::lock_guard lock(m_netlistMutex);
+                applyCommands();
+
+                if (!paused) {
+                    const auto deadline = now + maxBatch;
+                    if (rate <= 0.0) {
+                        do {
+                            runSlice(slice);
+                        } while (Clock::now() < deadline && !m_netlist.isIdle());
+                    } else {
+                        // a slow machine falls behind instead of piling up work
+                        owedTicks = std::min(owedTicks + elapsed * rate, std::max(rate * 0.25, 1.0));
+                        while (owedTicks >= 1.0 && Clock::now() < deadline) {
+                            const auto ticks = static_cast<uint64_t>(std::min(owedTicks, double(slice)));
+                            runSlice(ticks);
+                            owedTicks -= ticks;
+                        }
+                    }
+                }
+                idle = m_netlist.isIdle();
+
+                if (m_dirty)
+                    publish();
+            }
+
+            const double windowLength = std::chrono::duration<double>(Clock::now() - rateWindowStart).count();
+            if (windowLength >= 1.0) {
+                m_achievedTickRate = windowTicks / windowLength;
+                windowTicks = 0;
+                rateWindowStart = Clock::now();
+            }
+
+            // sleeps until the next tick is due, or a command or setting wakes it
+            double waitSeconds;
+            if (paused || (rate <= 0.0 && idle))
+                waitSeconds = 0.05;
+            else if (rate <= 0.0 || owedTicks >= 1.0)
+                continue;
+            else
+                waitSeconds = std::clamp((1.0 - owedTicks) / rate, 0.001, 0.05);
+
+            std::unique_lock lock(m_commandsMutex);
+            m_wake.wait_for(lock, std::chrono::duration<double>(waitSeconds), [&] {
+                return !m_running || !m_commands.empty() || m_paused != paused || m_tickRate != rate;
+            });
+        }
+    }
+} // namespace Bess::Simulator
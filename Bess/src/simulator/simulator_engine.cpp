@@ -1,155 +1,258 @@
 #include "simulator/simulator_engine.h"
-#include <stack>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
 #include <stdexcept>
 
-#include "components/input_probe.h"
-#include "components/jcomponent.h"
-#include "components_manager/components_manager.h"
-
 namespace Bess::Simulator {
 
-    std::queue<Engine::SimQueueElement> Engine::currentSimQueue, Engine::nextSimQueue;
-
-    // Function to apply a binary operator to two operands
-    int Engine::applyBinaryOperator(int a, int b, char op) {
-        switch (op) {
-        case '+':
-            return (a + b) >= 1 ? 1 : 0;
-        case '*':
-            return a * b;
-        case '^':
-            return a ^ b;
-        default:
-            throw std::runtime_error("Unsupported binary operator");
-        }
+    Netlist Engine::m_netlist;
+    SimulationThread Engine::m_thread(Engine::m_netlist);
+    SimulationMode Engine::m_mode = SimulationMode::eventDriven;
+    std::unique_ptr<TraceRecorder> Engine::m_trace = nullptr;
+    std::vector<TraceSignal> Engine::m_tracedSignals = {};
+    std::unique_ptr<SimulationHistory> Engine::m_history = nullptr;
+    std::unordered_set<uuids::uuid> Engine::m_oscillatingNodes = {};
+    size_t Engine::m_oscillatingLoopCount = 0;
+    uint64_t Engine::m_oscillationRevision = 0;
+    bool Engine::m_freezeOscillations = false;
+
+    void Engine::RefreshSimulation() {
+        m_thread.push([](Netlist &netlist) { netlist.refresh(); });
     }
 
-    // Function to apply the unary NOT operator
-    int Engine::applyUnaryOperator(int a, char op) {
-        if (op == '!')
-            return !a;
-        throw std::runtime_error("Unsupported unary operator");
-    }
-
-    // Function to evaluate the expression
-    int Engine::evaluateExpression(const std::string &expr, const std::vector<int> &values) {
-        std::stack<int> operands;
-        std::stack<char> operators;
-
-        auto precedence = [](char op) {
-            switch (op) {
-            case '!':
-                return 3;
-            case '*':
-                return 2;
-            case '^':
-                return 2;
-            case '+':
-                return 1;
-            default:
-                return 0;
-            }
-        };
-
-        auto applyTopOperator = [&]() {
-            char op = operators.top();
-            operators.pop();
-            if (op == '!') {
-                int a = operands.top();
-                operands.pop();
-                operands.push(applyUnaryOperator(a, op));
-            } else {
-                int b = operands.top();
-                operands.pop();
-                int a = operands.top();
-                operands.pop();
-                operands.push(applyBinaryOperator(a, b, op));
-            }
-        };
-
-        for (size_t i = 0; i < expr.size(); ++i) {
-            if (isspace(expr[i]))
-                continue; // Skip whitespaces
-
-            if (isdigit(expr[i])) {
-                int index = expr[i] - '0';
-                if (index >= values.size()) {
-                    throw std::out_of_range("Index out of range in the values array");
-                }
-                operands.push(values[index]);
-            } else if (expr[i] == '(') {
-                operators.push('(');
-            } else if (expr[i] == ')') {
-                while (!operators.empty() && operators.top() != '(') {
-                    applyTopOperator();
-                }
-                operators.pop(); // Remove '('
-            } else if (expr[i] == '+' || expr[i] == '*' || expr[i] == '^') {
-                while (!operators.empty() && precedence(operators.top()) >= precedence(expr[i])) {
-                    applyTopOperator();
-                }
-                operators.push(expr[i]);
-            } else if (expr[i] == '!') {
-                operators.push('!');
-            } else {
-                throw std::runtime_error("Invalid character in expression");
+    void Engine::Simulate() {
+        m_thread.step();
+    }
+
+    void Engine::clearQueue() {
+        m_thread.edit([](Netlist &netlist) { netlist.clearQueue(); });
+    }
+
+    void Engine::start() {
+        m_thread.start();
+    }
+
+    void Engine::stop() {
+        m_thread.stop();
+    }
+
+    Netlist &Engine::getNetlist() {
+        return m_netlist;
+    }
+
+    uint64_t Engine::push(SimulationThread::Command command) {
+        return m_thread.push(std::move(command));
+    }
+
+    void Engine::drivePin(int pin, DigitalState state) {
+        m_thread.push([pin, state](Netlist &netlist) {
+            netlist.drivePin(pin, state);
+            if (m_history)
+                m_history->recordInput(netlist.getTime(), pin, state);
+        });
+    }
+
+    void Engine::drivePin(const uuids::uuid &uid, DigitalState state) {
+        m_thread.push([uid, state](Netlist &netlist) {
+            int pin = netlist.getPinId(uid);
+            if (pin == Netlist::invalidId)
+                return;
+            netlist.drivePin(pin, state);
+            if (m_history)
+                m_history->recordInput(netlist.getTime(), pin, state);
+        });
+    }
+
+    int Engine::getPinId(const uuids::uuid &pin, uint64_t command) {
+        return m_thread.getPinId(pin, command);
+    }
+
+    void Engine::update() {
+        m_thread.acquireSnapshot();
+
+        if (m_thread.getOscillationRevision() == m_oscillationRevision)
+            return;
+        m_oscillationRevision = m_thread.getOscillationRevision();
+        auto loops = m_thread.getOscillatingLoops();
+
+        std::unordered_set<uuids::uuid> nodes;
+        for (auto &loop : loops) {
+            bool reported = true;
+            for (auto &node : loop.nodes)
+                reported &= m_oscillatingNodes.contains(node);
+            if (!reported) {
+                std::cerr << "[-] Feedback loop of " << loop.nodes.size() << " components oscillates"
+                          << (loop.frozen ? ", it was frozen" : "") << std::endl;
             }
+            nodes.insert(loop.nodes.begin(), loop.nodes.end());
         }
+        m_oscillatingNodes = std::move(nodes);
+        m_oscillatingLoopCount = loops.size();
+    }
 
-        // Apply remaining operators
-        while (!operators.empty()) {
-            applyTopOperator();
-        }
+    DigitalState Engine::getPinState(int pin) {
+        const auto &snapshot = m_thread.getSnapshot();
+        // pins added after the last snapshot read low until the next one
+        if (pin < 0 || pin >= snapshot.size())
+            return DigitalState::low;
+        return static_cast<DigitalState>(snapshot[pin]);
+    }
 
-        return operands.top();
+    void Engine::setPaused(bool paused) {
+        m_thread.setPaused(paused);
     }
 
-    void Engine::RefreshSimulation() {
-        for (auto &comp : Simulator::ComponentsManager::components) {
-            if (comp.second->getType() != ComponentType::inputProbe)
-                continue;
-            addToSimQueue(comp.first, comp.first, DigitalState::low);
+    void Engine::setTickRate(double rate) {
+        m_thread.setTickRate(rate);
+    }
+
+    double Engine::getTickRate() {
+        return m_thread.getTickRate();
+    }
+
+    double Engine::getAchievedTickRate() {
+        return m_thread.getAchievedTickRate();
+    }
+
+    void Engine::setMode(SimulationMode mode, size_t threadCount) {
+        m_mode = mode;
+        m_thread.setLevelized(mode == SimulationMode::levelized, threadCount);
+    }
+
+    SimulationMode Engine::getMode() {
+        return m_mode;
+    }
+
+    void Engine::setTracing(bool enabled) {
+        if (enabled == isTracing())
+            return;
+
+        if (!enabled) {
+            m_thread.edit([](Netlist &netlist) { netlist.setTraceRecorder(nullptr); });
+            m_trace = nullptr;
+            return;
         }
+
+        m_trace = std::make_unique<TraceRecorder>();
+        m_thread.edit([trace = m_trace.get()](Netlist &netlist) {
+            netlist.setTraceRecorder(trace);
+            // the signals picked before start from their current state
+            for (auto &signal : m_tracedSignals)
+                netlist.setPinTraced(signal.pin, true);
+        });
     }
 
-    void Engine::Simulate() {
-        currentSimQueue = nextSimQueue;
-        nextSimQueue = {};
-        std::unordered_map<uuids::uuid, bool> done = {};
-        while (!currentSimQueue.empty()) {
-            auto el = currentSimQueue.front();
-            currentSimQueue.pop();
-            if (done.find(el.uid) != done.end())
-                continue;
-            done[el.uid] = true;
-
-            auto &comp = ComponentsManager::components[el.uid];
-            if (comp->getType() == ComponentType::jcomponent) {
-                auto jcomp = (Components::JComponent *)ComponentsManager::components[el.uid].get();
-                jcomp->simulate();
-            } else if (comp->getType() == ComponentType::inputProbe) {
-                auto inpProbe = (Components::InputProbe *)comp.get();
-                if (el.state == low)
-                    inpProbe->refresh();
-                else {
-                    inpProbe->simulate();
-                }
-            } else if (comp->getType() == ComponentType::inputSlot || comp->getType() == ComponentType::outputSlot) {
-                auto slot = (Components::Slot *)ComponentsManager::components[el.uid].get();
-                slot->simulate(el.changerId, el.state);
-            } else {
-                comp->simulate();
-            }
+    bool Engine::isTracing() {
+        return m_trace != nullptr;
+    }
+
+    void Engine::traceSignal(const TraceSignal &signal) {
+        if (std::ranges::any_of(m_tracedSignals, [&](auto &traced) { return traced.pin == signal.pin; }))
+            return;
+        m_tracedSignals.emplace_back(signal);
+        m_thread.push([pin = signal.pin](Netlist &netlist) { netlist.setPinTraced(pin, true); });
+    }
+
+    void Engine::clearTracedSignals() {
+        m_thread.edit([](Netlist &netlist) {
+            for (auto &signal : m_tracedSignals)
+                netlist.setPinTraced(signal.pin, false);
+        });
+        m_tracedSignals.clear();
+    }
+
+    const std::vector<TraceSignal> &Engine::getTracedSignals() {
+        return m_tracedSignals;
+    }
+
+    void Engine::exportTrace(const std::string &path) {
+        if (!m_trace)
+            throw std::runtime_error("Start tracing before exporting a trace");
+
+        std::ofstream file(path);
+        if (!file)
+            throw std::runtime_error("Cannot write the trace to " + path);
+        // the simulation thread writes the ring buffer, it is read between two steps
+        m_thread.edit([&file](Netlist &) { m_trace->writeVcd(file, m_tracedSignals); });
+    }
+
+    void Engine::setHistoryEnabled(bool enabled) {
+        if (enabled == isHistoryEnabled())
+            return;
+        if (!enabled) {
+            m_thread.setHistory(nullptr);
+            // commands already queued may still record inputs
+            m_thread.edit([](Netlist &) { m_history = nullptr; });
+            return;
         }
+        auto history = std::make_unique<SimulationHistory>();
+        m_thread.setHistory(history.get());
+        m_thread.edit([&history](Netlist &netlist) {
+            m_history = std::move(history);
+            m_history->capture(netlist);
+        });
     }
 
-    void Engine::addToSimQueue(const uuids::uuid &uid, const uuids::uuid &changerId, Simulator::DigitalState state) {
-        SimQueueElement el{uid, changerId, state};
-        nextSimQueue.push(el);
+    bool Engine::isHistoryEnabled() {
+        return m_history != nullptr;
     }
 
-    void Engine::clearQueue() {
-        nextSimQueue = {};
-        currentSimQueue = {};
+    void Engine::setHistoryInterval(SimTime interval) {
+        if (m_history)
+            m_thread.edit([interval](Netlist &) { m_history->setInterval(interval); });
+    }
+
+    SimTime Engine::getHistoryInterval() {
+        return m_history ? m_history->getInterval() : SimulationHistory::defaultInterval;
+    }
+
+    bool Engine::rewindTo(SimTime time) {
+        if (!m_history)
+            return false;
+        return m_thread.edit([time](Netlist &netlist) {
+            if (!m_history->rewind(netlist, time))
+                return false;
+            if (m_trace)
+                m_trace->clear();
+            return true;
+        });
+    }
+
+    bool Engine::stepBack() {
+        if (!m_history)
+            return false;
+        const SimTime time = m_thread.getTime();
+        const SimTime interval = m_history->getInterval();
+        return rewindTo(time > interval ? time - interval : 0);
+    }
+
+    SimTime Engine::getHistoryStart() {
+        return m_history ? m_history->getOldestTime() : 0;
+    }
+
+    SimTime Engine::getTime() {
+        return m_thread.getTime();
+    }
+
+    bool Engine::isOscillating(const uuids::uuid &node) {
+        return !m_oscillatingNodes.empty() && m_oscillatingNodes.contains(node);
+    }
+
+    size_t Engine::getOscillatingLoopCount() {
+        return m_oscillatingLoopCount;
+    }
+
+    void Engine::setFreezeOscillations(bool freeze) {
+        m_freezeOscillations = freeze;
+        m_thread.push([freeze](Netlist &netlist) { netlist.setFreezeOscillations(freeze); });
+    }
+
+    bool Engine::getFreezeOscillations() {
+        return m_freezeOscillations;
+    }
+
+    void Engine::releaseLoops() {
+        m_thread.push([](Netlist &netlist) { netlist.releaseLoops(); });
     }
 } // namespace Bess::Simulator
@@ -0,0 +1,25 @@
+#include "simulator/snapshot_buffer.h"
+
+namespace Bess::Simulator {
+
+    std::vector<uint8_t> &SnapshotBuffer::getBackBuffer() {
+        return m_buffers[m_back];
+    }
+
+    void SnapshotBuffer::publish() {
+        int prev = m_middle.exchange(m_back | freshBit, std::memory_order_acq_rel);
+        m_back = prev & indexMask;
+    }
+
+    bool SnapshotBuffer::acquire() {
+        if (!(m_middle.load(std::memory_order_relaxed) & freshBit))
+            return false;
+        int prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = prev & indexMask;
+        return true;
+    }
+
+    const std::vector<uint8_t> &SnapshotBuffer::getFrontBuffer() const {
+        return m_buffers[m_front];
+    }
+} // namespace Bess::Simulator
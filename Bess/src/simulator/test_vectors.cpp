@@ -0,0 +1,223 @@
+#include "simulator/test_vectors.h"
+
+#include "simulator/thread_pool.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Bess::Simulator {
+    namespace {
+        // ticks run between two checks for an idle netlist
+        constexpr SimTime settleSlice = 64;
+
+        std::string trim(const std::string &str) {
+            const auto begin = str.find_first_not_of(" \t\r\n");
+            if (begin == std::string::npos)
+                return "";
+            const auto end = str.find_last_not_of(" \t\r\n");
+            return str.substr(begin, end - begin + 1);
+        }
+
+        std::vector<std::string> splitCsvRow(const std::string &row) {
+            std::vector<std::string> cells;
+            std::stringstream stream(row);
+            std::string cell;
+            while (std::getline(stream, cell, ','))
+                cells.emplace_back(trim(cell));
+            // a trailing comma ends with an empty cell
+            if (!row.empty() && row.back() == ',')
+                cells.emplace_back("");
+            return cells;
+        }
+
+        int parseValue(const std::string &value, size_t line) {
+            if (value == "0")
+                return 0;
+            if (value == "1")
+                return 1;
+            if (value == "x" || value == "X" || value == "-")
+                return -1;
+            throw std::runtime_error("Test vector " + std::to_string(line) + " has the value " + value + ", expected 0, 1 or x");
+        }
+
+        TestStep parseJsonStep(const nlohmann::json &json, size_t index) {
+            if (!json.is_object())
+                throw std::runtime_error("Test vector " + std::to_string(index) + " is not an object of probe values");
+
+            TestStep step{{}, index};
+            for (auto &[label, value] : json.items()) {
+                if (value.is_boolean())
+                    step.values.emplace_back(label, value.get<bool>() ? 1 : 0);
+                else if (value.is_number_integer())
+                    step.values.emplace_back(label, parseValue(std::to_string(value.get<int>()), index));
+                else if (value.is_string())
+                    step.values.emplace_back(label, parseValue(value.get<std::string>(), index));
+                else
+                    throw std::runtime_error("Test vector " + std::to_string(index) + " has an invalid value for " + label);
+            }
+            return step;
+        }
+    } // namespace
+
+    TestVectorFile TestVectorFile::load(const std::string &path) {
+        std::ifstream file(path);
+        if (!file)
+            throw std::runtime_error("Cannot open test vectors " + path);
+
+        if (path.ends_with(".json"))
+            return fromJson(nlohmann::json::parse(file));
+        return fromCsv(file);
+    }
+
+    TestVectorFile TestVectorFile::fromCsv(std::istream &stream) {
+        TestVectorFile vectors;
+        std::vector<std::string> labels;
+        std::string row;
+        for (size_t line = 1; std::getline(stream, row); line++) {
+            if (trim(row).empty())
+                continue;
+
+            auto cells = splitCsvRow(row);
+            if (labels.empty()) {
+                labels = std::move(cells);
+                continue;
+            }
+            if (cells.size() > labels.size())
+                throw std::runtime_error("Test vector on line " + std::to_string(line) + " has more values than labels");
+
+            TestStep step{{}, line};
+            for (size_t i = 0; i < cells.size(); i++) {
+                if (!cells[i].empty())
+                    step.values.emplace_back(labels[i], parseValue(cells[i], line));
+            }
+            vectors.tests.push_back({std::move(step)});
+        }
+        return vectors;
+    }
+
+    TestVectorFile TestVectorFile::fromJson(const nlohmann::json &json) {
+        TestVectorFile vectors;
+        size_t index = 0;
+        if (json.contains("vectors")) {
+            for (auto &vector : json.at("vectors"))
+                vectors.tests.push_back({parseJsonStep(vector, index++)});
+        }
+        if (json.contains("sequences")) {
+            for (auto &sequence : json.at("sequences")) {
+                std::vector<TestStep> steps;
+                for (auto &vector : sequence)
+                    steps.emplace_back(parseJsonStep(vector, index++));
+                vectors.tests.emplace_back(std::move(steps));
+            }
+        }
+        return vectors;
+    }
+
+    TestRunner::TestRunner(const Netlist &netlist, std::vector<Probe> inputs, std::vector<Probe> outputs)
+        : m_netlist(netlist), m_inputs(std::move(inputs)), m_outputs(std::move(outputs)) {
+        m_netlist.setTraceRecorder(nullptr);
+        m_netlist.setDeferredEvaluator(nullptr);
+        m_netlist.trackChanges(false);
+        // drives still queued on the original would be lost by the snapshots
+        settle(m_netlist);
+    }
+
+    void TestRunner::setSettleTicks(SimTime ticks) {
+        m_settleTicks = ticks;
+    }
+
+    TestRunner::Report TestRunner::run(const TestVectorFile &vectors, size_t threadCount) const {
+        const auto tests = resolve(vectors);
+
+        Report report;
+        report.tests = tests.size();
+        for (auto &test : tests)
+            report.steps += test.size();
+
+        ThreadPool pool(threadCount);
+        const size_t grain = std::max<size_t>(tests.size() / (pool.getThreadCount() * 4), 1);
+        std::mutex reportMutex;
+
+        pool.parallelFor(tests.size(), grain, [&](size_t begin, size_t end) {
+            // every test starts from the state of the original netlist
+            Netlist netlist = m_netlist;
+            const auto initial = netlist.takeSnapshot();
+
+            std::vector<Mismatch> mismatches;
+            size_t failed = 0;
+            for (size_t test = begin; test < end; test++) {
+                if (test > begin)
+                    netlist.restoreSnapshot(initial);
+
+                bool passed = true;
+                for (size_t step = 0; step < tests[test].size(); step++) {
+                    auto &resolved = tests[test][step];
+                    for (auto &[pin, state] : resolved.inputs)
+                        netlist.drivePin(pin, state);
+                    settle(netlist);
+
+                    for (auto &[probe, expected] : resolved.expected) {
+                        auto actual = netlist.getPinState(m_outputs[probe].pin);
+                        if (actual == expected)
+                            continue;
+                        mismatches.push_back({test, step, resolved.line, m_outputs[probe].label, expected, actual});
+                        passed = false;
+                    }
+                }
+                if (!passed)
+                    failed++;
+            }
+
+            std::lock_guard lock(reportMutex);
+            report.failedTests += failed;
+            report.mismatches.insert(report.mismatches.end(), mismatches.begin(), mismatches.end());
+        });
+
+        std::ranges::stable_sort(report.mismatches, [](const Mismatch &a, const Mismatch &b) {
+            return a.test != b.test ? a.test < b.test : a.step < b.step;
+        });
+        return report;
+    }
+
+    std::vector<std::vector<TestRunner::ResolvedStep>> TestRunner::resolve(const TestVectorFile &vectors) const {
+        std::unordered_map<std::string, int> inputs, outputs;
+        for (int i = 0; i < m_inputs.size(); i++)
+            inputs[m_inputs[i].label] = i;
+        for (int i = 0; i < m_outputs.size(); i++)
+            outputs[m_outputs[i].label] = i;
+
+        std::vector<std::vector<ResolvedStep>> tests;
+        tests.reserve(vectors.tests.size());
+        for (auto &test : vectors.tests) {
+            auto &steps = tests.emplace_back();
+            for (auto &step : test) {
+                ResolvedStep resolved{{}, {}, step.line};
+                for (auto &[label, value] : step.values) {
+                    const auto state = value == 1 ? DigitalState::high : DigitalState::low;
+                    if (auto input = inputs.find(label); input != inputs.end()) {
+                        if (value < 0)
+                            throw std::runtime_error("Test vector " + std::to_string(step.line) + " leaves input " + label + " at x");
+                        resolved.inputs.emplace_back(m_inputs[input->second].pin, state);
+                    } else if (auto output = outputs.find(label); output != outputs.end()) {
+                        if (value >= 0)
+                            resolved.expected.emplace_back(output->second, state);
+                    } else {
+                        throw std::runtime_error("Test vector " + std::to_string(step.line) + " names " + label + ", which is not a probe label");
+                    }
+                }
+                steps.emplace_back(std::move(resolved));
+            }
+        }
+        return tests;
+    }
+
+    void TestRunner::settle(Netlist &netlist) const {
+        const SimTime end = netlist.getTime() + m_settleTicks;
+        while (!netlist.isIdle() && netlist.getTime() < end)
+            netlist.runUntil(std::min(end, netlist.getTime() + settleSlice));
+    }
+} // namespace Bess::Simulator
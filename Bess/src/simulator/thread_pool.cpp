@@ -0,0 +1,112 @@
+#include "simulator/thread_pool.h"
+
+#include <algorithm>
+
+namespace Bess::Simulator {
+
+    ThreadPool::ThreadPool(size_t threadCount) {
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+        for (size_t i = 0; i < threadCount; i++)
+            m_queues.emplace_back(std::make_unique<TaskQueue>());
+
+        for (size_t i = 0; i + 1 < threadCount; i++)
+            m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(m_wakeMutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+
+        for (auto &thread : m_threads)
+            thread.join();
+    }
+
+    size_t ThreadPool::getThreadCount() const {
+        return m_queues.size();
+    }
+
+    void ThreadPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)> &fn) {
+        if (count == 0)
+            return;
+
+        grain = std::max<size_t>(grain, 1);
+        const size_t taskCount = (count + grain - 1) / grain;
+        if (taskCount == 1 || m_threads.empty()) {
+            fn(0, count);
+            return;
+        }
+
+        // counted before pushing, so taking a task never underflows the counter
+        {
+            std::lock_guard lock(m_wakeMutex);
+            m_queuedTasks += taskCount;
+        }
+
+        std::atomic<size_t> remaining = taskCount;
+        for (size_t i = 0; i < taskCount; i++) {
+            auto &queue = *m_queues[i % m_queues.size()];
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back({i * grain, std::min(count, (i + 1) * grain), &fn, &remaining});
+        }
+        m_wake.notify_all();
+
+        const size_t self = m_queues.size() - 1;
+        Task task;
+        while (remaining.load(std::memory_order_acquire) > 0) {
+            if (takeTask(self, task))
+                runTask(task);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    bool ThreadPool::takeTask(size_t index, Task &task) {
+        {
+            auto &own = *m_queues[index];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = own.tasks.front();
+                own.tasks.pop_front();
+                m_queuedTasks--;
+                return true;
+            }
+        }
+
+        for (size_t i = 1; i < m_queues.size(); i++) {
+            auto &victim = *m_queues[(index + i) % m_queues.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                m_queuedTasks--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::runTask(const Task &task) {
+        (*task.fn)(task.begin, task.end);
+        task.remaining->fetch_sub(1, std::memory_order_release);
+    }
+
+    void ThreadPool::workerLoop(size_t index) {
+        Task task;
+        while (true) {
+            if (takeTask(index, task)) {
+                runTask(task);
+                continue;
+            }
+
+            std::unique_lock lock(m_wakeMutex);
+            m_wake.wait(lock, [this] { return m_stop || m_queuedTasks > 0; });
+            if (m_stop)
+                return;
+        }
+    }
+} // namespace Bess::Simulator
@@ -0,0 +1,171 @@
+#include "simulator/timing_wheel.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Bess::Simulator {
+
+    TimingWheel::TimingWheel() {
+        for (auto &level : m_slots)
+            level.fill(invalidHandle);
+    }
+
+    int TimingWheel::schedule(SimTime time, const SimEvent &event) {
+        assert(time > m_time);
+
+        int handle;
+        if (!m_freeEvents.empty()) {
+            handle = m_freeEvents.back();
+            m_freeEvents.pop_back();
+        } else {
+            handle = static_cast<int>(m_pool.size());
+            m_pool.emplace_back();
+        }
+
+        m_pool[handle] = {time, event, invalidHandle, false};
+        insert(handle);
+        m_size++;
+        return handle;
+    }
+
+    void TimingWheel::cancel(int handle) {
+        auto &ev = m_pool[handle];
+        if (ev.cancelled)
+            return;
+        ev.cancelled = true;
+        m_size--;
+    }
+
+    SimTime TimingWheel::getEventTime(int handle) const {
+        return m_pool[handle].time;
+    }
+
+    const SimEvent &TimingWheel::getEvent(int handle) const {
+        return m_pool[handle].event;
+    }
+
+    void TimingWheel::insert(int handle) {
+        auto &ev = m_pool[handle];
+        const SimTime delta = ev.time - m_time;
+
+        for (int level = 0; level < levelCount; level++) {
+            if (delta < (SimTime(1) << (levelBits * (level + 1)))) {
+                auto &head = m_slots[level][(ev.time >> (levelBits * level)) & (slotCount - 1)];
+                ev.next = head;
+                head = handle;
+                m_levelCounts[level]++;
+                return;
+            }
+        }
+
+        m_overflow.emplace_back(handle);
+    }
+
+    void TimingWheel::cascade(int level) {
+        auto &head = m_slots[level][(m_time >> (levelBits * level)) & (slotCount - 1)];
+        int handle = head;
+        head = invalidHandle;
+
+        while (handle != invalidHandle) {
+            int next = m_pool[handle].next;
+            m_levelCounts[level]--;
+            if (m_pool[handle].cancelled)
+                release(handle);
+            else
+                insert(handle);
+            handle = next;
+        }
+    }
+
+    void TimingWheel::release(int handle) {
+        m_freeEvents.emplace_back(handle);
+    }
+
+    void TimingWheel::advance(std::vector<SimEvent> &due) {
+        m_time++;
+
+        // whenever a level completes a turn, the next level's current slot moves down
+        for (int level = 1; level < levelCount; level++) {
+            if ((m_time >> (levelBits * (level - 1))) & (slotCount - 1))
+                break;
+            cascade(level);
+
+            if (level == levelCount - 1 && ((m_time >> (levelBits * level)) & (slotCount - 1)) == 0) {
+                auto overflow = std::move(m_overflow);
+                m_overflow.clear();
+                for (auto handle : overflow)
+                    insert(handle);
+            }
+        }
+
+        auto &head = m_slots[0][m_time & (slotCount - 1)];
+        int handle = head;
+        head = invalidHandle;
+
+        while (handle != invalidHandle) {
+            auto &ev = m_pool[handle];
+            int next = ev.next;
+            m_levelCounts[0]--;
+            if (!ev.cancelled) {
+                due.emplace_back(ev.event);
+                m_size--;
+            }
+            release(handle);
+            handle = next;
+        }
+    }
+
+    SimTime TimingWheel::getIdleUntil() const {
+        // a level's events can only move down at its next slot boundary
+        auto nextBoundary = [this](int level) {
+            const SimTime span = SimTime(1) << (levelBits * level);
+            return (m_time | (span - 1)) + 1;
+        };
+
+        SimTime limit = UINT64_MAX;
+        if (!m_overflow.empty())
+            limit = nextBoundary(levelCount) - 1;
+        for (int level = 1; level < levelCount; level++) {
+            if (m_levelCounts[level] > 0)
+                limit = std::min(limit, nextBoundary(level) - 1);
+        }
+
+        if (m_levelCounts[0] == 0)
+            return limit;
+
+        // level 0 events are due exactly at the time of their slot
+        for (SimTime time = m_time + 1; time <= limit && time < m_time + slotCount; time++) {
+            if (m_slots[0][time & (slotCount - 1)] != invalidHandle)
+                return time - 1;
+        }
+        return std::min(limit, m_time + slotCount - 1);
+    }
+
+    void TimingWheel::skipTo(SimTime time) {
+        assert(time >= m_time && time <= getIdleUntil());
+        m_time = time;
+    }
+
+    SimTime TimingWheel::getTime() const {
+        return m_time;
+    }
+
+    size_t TimingWheel::size() const {
+        return m_size;
+    }
+
+    void TimingWheel::clear() {
+        for (auto &level : m_slots)
+            level.fill(invalidHandle);
+        m_pool.clear();
+        m_freeEvents.clear();
+        m_overflow.clear();
+        m_levelCounts.fill(0);
+        m_size = 0;
+    }
+
+    void TimingWheel::reset(SimTime time) {
+        clear();
+        m_time = time;
+    }
+} // namespace Bess::Simulator
@@ -0,0 +1,108 @@
+#include "simulator/trace_recorder.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+
+namespace Bess::Simulator {
+    namespace {
+        // short printable identifier of the nth signal, as VCD expects
+        std::string vcdId(size_t index) {
+            std::string id;
+            do {
+                id += static_cast<char>('!' + index % 94);
+                index /= 94;
+            } while (index > 0);
+            return id;
+        }
+
+        // VCD references are whitespace separated
+        std::string vcdName(const std::string &name) {
+            std::string res = name.empty() ? "signal" : name;
+            std::ranges::replace_if(res, [](char ch) { return std::isspace(static_cast<unsigned char>(ch)); }, '_');
+            return res;
+        }
+
+        void writeValue(std::ostream &stream, uint64_t value, int width, const std::string &id) {
+            if (width == 1) {
+                stream << (value & 1 ? '1' : '0') << id << '\n';
+                return;
+            }
+            std::string bits;
+            for (int i = std::max<int>(std::bit_width(value), 1) - 1; i >= 0; i--)
+                bits += (value >> i) & 1 ? '1' : '0';
+            stream << 'b' << bits << ' ' << id << '\n';
+        }
+    } // namespace
+
+    TraceRecorder::TraceRecorder(size_t capacity) {
+        capacity = std::bit_ceil(std::max<size_t>(capacity, 1));
+        m_records.resize(capacity);
+        m_mask = capacity - 1;
+    }
+
+    void TraceRecorder::clear() {
+        m_head = 0;
+    }
+
+    std::vector<TraceRecorder::Record> TraceRecorder::getRecords() const {
+        const uint64_t first = m_head > m_records.size() ? m_head - m_records.size() : 0;
+        std::vector<Record> records;
+        records.reserve(m_head - first);
+        for (uint64_t i = first; i < m_head; i++)
+            records.emplace_back(m_records[i & m_mask]);
+
+        // records of one levelized pass can land out of order
+        std::ranges::stable_sort(records, {}, &Record::time);
+        return records;
+    }
+
+    size_t TraceRecorder::getCapacity() const {
+        return m_records.size();
+    }
+
+    uint64_t TraceRecorder::getRecordedCount() const {
+        return m_head;
+    }
+
+    void TraceRecorder::writeVcd(std::ostream &stream, const std::vector<TraceSignal> &signals) const {
+        // signal index of every pin, -1 for the pins not written
+        std::vector<int> pinSignals;
+        std::vector<std::string> ids;
+        for (size_t i = 0; i < signals.size(); i++) {
+            ids.emplace_back(vcdId(i));
+            const int pin = signals[i].pin;
+            if (pin < 0)
+                continue;
+            if (pin >= pinSignals.size())
+                pinSignals.resize(pin + 1, -1);
+            pinSignals[pin] = static_cast<int>(i);
+        }
+
+        stream << "$version Bess $end\n"
+               << "$timescale 1ns $end\n"
+               << "$scope module bess $end\n";
+        for (size_t i = 0; i < signals.size(); i++)
+            stream << "$var wire " << signals[i].width << ' ' << ids[i] << ' ' << vcdName(signals[i].name) << " $end\n";
+        stream << "$upscope $end\n"
+               << "$enddefinitions $end\n"
+               << "$dumpvars\n";
+        for (size_t i = 0; i < signals.size(); i++)
+            stream << (signals[i].width == 1 ? "x" : "bx ") << ids[i] << '\n';
+        stream << "$end\n";
+
+        bool first = true;
+        SimTime time = 0;
+        for (const auto &rec : getRecords()) {
+            if (rec.pin >= pinSignals.size() || pinSignals[rec.pin] < 0)
+                continue;
+            if (first || rec.time != time) {
+                time = rec.time;
+                first = false;
+                stream << '#' << time << '\n';
+            }
+            const int signal = pinSignals[rec.pin];
+            writeValue(stream, rec.value, signals[signal].width, ids[signal]);
+        }
+    }
+} // namespace Bess::Simulator
@@ -0,0 +1,227 @@
+#include "simulator/word_expression.h"
+
+#include <cctype>
+#include <stdexcept>
+
+namespace Bess::Simulator {
+
+    WordExpression::WordExpression(const std::string &expr, int inputCount) {
+        if (inputCount > maxInputs)
+            throw std::out_of_range("Expressions support at most " + std::to_string(maxInputs) + " inputs");
+
+        // shunting-yard, two character operators are stored as one character:
+        // 'l' <<, 'r' >>, '=' ==
+        std::vector<char> operators = {};
+        int depth = 0;
+
+        auto precedence = [](char op) {
+            switch (op) {
+            case '~':
+                return 9;
+            case '*':
+                return 8;
+            case '+':
+            case '-':
+                return 7;
+            case 'l':
+            case 'r':
+                return 6;
+            case '<':
+            case '>':
+                return 5;
+            case '=':
+                return 4;
+            case '&':
+                return 3;
+            case '^':
+                return 2;
+            case '|':
+                return 1;
+            default:
+                return 0;
+            }
+        };
+
+        auto push = [&](OpCode op, uint64_t operand) {
+            m_program.push_back({op, operand});
+            if (++depth > maxStackDepth)
+                throw std::runtime_error("Expression is too deeply nested");
+        };
+
+        auto emitTopOperator = [&]() {
+            char op = operators.back();
+            operators.pop_back();
+            if (op == '~') {
+                if (depth < 1)
+                    throw std::runtime_error("Missing operand in expression");
+                m_program.push_back({OpCode::notOp, 0});
+                return;
+            }
+
+            OpCode code;
+            switch (op) {
+            case '*':
+                code = OpCode::mulOp;
+                break;
+            case '+':
+                code = OpCode::addOp;
+                break;
+            case '-':
+                code = OpCode::subOp;
+                break;
+            case 'l':
+                code = OpCode::shlOp;
+                break;
+            case 'r':
+                code = OpCode::shrOp;
+                break;
+            case '<':
+                code = OpCode::lessOp;
+                break;
+            case '>':
+                code = OpCode::greaterOp;
+                break;
+            case '=':
+                code = OpCode::equalOp;
+                break;
+            case '&':
+                code = OpCode::andOp;
+                break;
+            case '^':
+                code = OpCode::xorOp;
+                break;
+            case '|':
+                code = OpCode::orOp;
+                break;
+            default:
+                throw std::runtime_error("Unbalanced parentheses in expression");
+            }
+            if (depth < 2)
+                throw std::runtime_error("Missing operand in expression");
+            m_program.push_back({code, 0});
+            depth--;
+        };
+
+        for (size_t i = 0; i < expr.size(); ++i) {
+            char ch = expr[i];
+            if (isspace(ch))
+                continue;
+
+            if (isdigit(ch)) {
+                int index = ch - '0';
+                if (index >= inputCount)
+                    throw std::out_of_range("Index out of range in the values array");
+                push(OpCode::input, index);
+                continue;
+            }
+
+            if (ch == '#') {
+                size_t length = 0;
+                uint64_t value;
+                try {
+                    value = std::stoull(expr.substr(i + 1), &length, 0);
+                } catch (const std::exception &) {
+                    throw std::runtime_error("Invalid literal in expression");
+                }
+                push(OpCode::literal, value);
+                i += length;
+                continue;
+            }
+
+            if (ch == '(') {
+                operators.push_back('(');
+            } else if (ch == ')') {
+                while (!operators.empty() && operators.back() != '(')
+                    emitTopOperator();
+                if (operators.empty())
+                    throw std::runtime_error("Unbalanced parentheses in expression");
+                operators.pop_back();
+            } else if (ch == '~') {
+                operators.push_back('~');
+            } else {
+                char next = i + 1 < expr.size() ? expr[i + 1] : '\0';
+                if ((ch == '<' || ch == '>' || ch == '=') && next == ch) {
+                    ch = ch == '<' ? 'l' : ch == '>' ? 'r' : '=';
+                    i++;
+                } else if (ch == '=' || precedence(ch) == 0) {
+                    throw std::runtime_error("Invalid character in expression");
+                }
+                while (!operators.empty() && precedence(operators.back()) >= precedence(ch))
+                    emitTopOperator();
+                operators.push_back(ch);
+            }
+        }
+
+        while (!operators.empty())
+            emitTopOperator();
+
+        if (depth != 1)
+            throw std::runtime_error("Malformed expression");
+    }
+
+    uint64_t WordExpression::evaluate(const uint64_t *inputs) const {
+        uint64_t stack[maxStackDepth];
+        int top = -1;
+
+        for (const auto &ins : m_program) {
+            if (ins.op == OpCode::input) {
+                stack[++top] = inputs[ins.operand];
+                continue;
+            }
+            if (ins.op == OpCode::literal) {
+                stack[++top] = ins.operand;
+                continue;
+            }
+            if (ins.op == OpCode::notOp) {
+                stack[top] = ~stack[top];
+                continue;
+            }
+
+            const uint64_t rhs = stack[top--];
+            uint64_t &lhs = stack[top];
+            switch (ins.op) {
+            case OpCode::mulOp:
+                lhs *= rhs;
+                break;
+            case OpCode::addOp:
+                lhs += rhs;
+                break;
+            case OpCode::subOp:
+                lhs -= rhs;
+                break;
+            case OpCode::shlOp:
+                lhs = rhs < 64 ? lhs << rhs : 0;
+                break;
+            case OpCode::shrOp:
+                lhs = rhs < 64 ? lhs >> rhs : 0;
+                break;
+            case OpCode::lessOp:
+                lhs = lhs < rhs;
+                break;
+            case OpCode::greaterOp:
+                lhs = lhs > rhs;
+                break;
+            case OpCode::equalOp:
+                lhs = lhs == rhs;
+                break;
+            case OpCode::andOp:
+                lhs &= rhs;
+                break;
+            case OpCode::xorOp:
+                lhs ^= rhs;
+                break;
+            case OpCode::orOp:
+                lhs |= rhs;
+                break;
+            default:
+                break;
+            }
+        }
+
+        return stack[0];
+    }
+
+    const std::vector<WordExpression::Instruction> &WordExpression::getProgram() const {
+        return m_program;
+    }
+} // namespace Bess::Simulator
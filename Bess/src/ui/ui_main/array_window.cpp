@@ -0,0 +1,90 @@
+#include "ui/ui_main/array_window.h"
+#include "components_manager/components_manager.h"
+#include "imgui.h"
+#include "pages/main_page/main_page.h"
+#include "pages/main_page/main_page_state.h"
+#include "ui/m_widgets.h"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace Bess::UI {
+    void ArrayWindow::draw() {
+        if (!m_shown)
+            return;
+
+        ImGui::SetNextWindowSize(ImVec2(420, 240), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Place Array", &m_shown);
+
+        const auto element = Pages::MainPageState::getInstance()->getPrevGenBankElement();
+        if (element == nullptr) {
+            ImGui::TextWrapped("Place a component from the explorer first, the array repeats the last placed one.");
+            ImGui::End();
+            return;
+        }
+
+        ImGui::Text("Component: %s", element->getName().c_str());
+        ImGui::InputInt("Rows", &m_rows);
+        ImGui::InputInt("Columns", &m_cols);
+        m_rows = std::max(m_rows, 1);
+        m_cols = std::max(m_cols, 1);
+        ImGui::InputFloat2("Spacing", m_spacing);
+
+        ImGui::TextWrapped("Links wire each element to the next one in its row, e.g. \"Q->D\" or \"1->2\" for output 1 to input 2.");
+        MWidgets::TextBox("Links", m_links, "output->input, ...");
+
+        if (!m_error.empty())
+            ImGui::TextColored(ImVec4(0.9f, 0.3f, 0.3f, 1.f), "%s", m_error.c_str());
+
+        if (ImGui::Button("Place"))
+            place();
+        ImGui::End();
+    }
+
+    void ArrayWindow::place() {
+        m_error = "";
+        try {
+            std::vector<Simulator::ComponentsManager::ArrayLink> links;
+            std::stringstream ss(m_links);
+            std::string link;
+            while (std::getline(ss, link, ',')) {
+                link.erase(0, link.find_first_not_of(' '));
+                link.erase(link.find_last_not_of(' ') + 1);
+                if (link.empty())
+                    continue;
+                const auto arrow = link.find("->");
+                if (arrow == std::string::npos)
+                    throw std::runtime_error("Links are written as output->input, got " + link);
+                links.push_back({link.substr(0, arrow), link.substr(arrow + 2)});
+            }
+
+            const auto pos = Pages::MainPage::getTypedInstance()->getCameraPos();
+            const auto element = Pages::MainPageState::getInstance()->getPrevGenBankElement();
+            Simulator::ComponentsManager::generateArray(*element, m_rows, m_cols, {pos, 0.f}, {m_spacing[0], m_spacing[1]}, links);
+            hide();
+        } catch (const std::exception &e) {
+            m_error = e.what();
+        }
+    }
+
+    void ArrayWindow::show() {
+        m_error = "";
+        m_shown = true;
+    }
+
+    void ArrayWindow::hide() {
+        m_shown = false;
+    }
+
+    bool ArrayWindow::isShown() {
+        return m_shown;
+    }
+
+    bool ArrayWindow::m_shown = false;
+    int ArrayWindow::m_rows = 1;
+    int ArrayWindow::m_cols = 4;
+    float ArrayWindow::m_spacing[2] = {200.f, 150.f};
+    std::string ArrayWindow::m_links;
+    std::string ArrayWindow::m_error;
+
+} // namespace Bess::UI
@@ -43,7 +43,7 @@ namespace Bess::UI {
                         std::any data = NULL;
                         if (comp.getType() == Simulator::ComponentType::jcomponent) {
                             data = comp.getJCompData();
-                        } else if (comp.getType() == Simulator::ComponentType::flipFlop) {
+                        } else if (comp.getType() == Simulator::ComponentType::flipFlop || comp.getType() == Simulator::ComponentType::splitter || comp.getType() == Simulator::ComponentType::merger) {
                             data = name;
                         }
                         Simulator::ComponentsManager::generateComponent(comp.getType(), data, {pos, 0.f});
@@ -1,21 +1,45 @@
 #include "ui/ui_main/dialogs.h"
 #include "tinyfiledialogs.h"
 
+#include <algorithm>
+
 namespace Bess::UI {
     std::vector<std::string> Dialogs::filterList = {"*.bproj"};
 
     std::string Dialogs::showSaveFileDialog(const std::string &title, const std::string &filters) {
+        // no filter saves a project
+        if (filters.empty()) {
+            auto filepath = tinyfd_saveFileDialog("Open Bess Project", "", filterList.size(),
+                                                  (const char *const *)filterList.data(), "Bess Project");
+            return filepath == nullptr ? "" : filepath;
+        }
 
-        auto filepath = tinyfd_saveFileDialog("Open Bess Project", "", filterList.size(),
-                                              (const char *const *)filterList.data(), "Bess Project");
-
-        return filepath;
+        const char *pattern = filters.c_str();
+        auto filepath = tinyfd_saveFileDialog(title.c_str(), "", 1, &pattern, nullptr);
+        return filepath == nullptr ? "" : filepath;
     }
 
     std::string Dialogs::showOpenFileDialog(const std::string &title, const std::string &filters) {
-        auto filepath = tinyfd_openFileDialog("Open Bess Project", "", filterList.size(),
-                                              (const char *const *)filterList.data(), "Bess Project", false);
+        // the project filter opens a project
+        if (filters.empty() || filters.starts_with("*.bproj")) {
+            auto filepath = tinyfd_openFileDialog("Open Bess Project", "", filterList.size(),
+                                                  (const char *const *)filterList.data(), "Bess Project", false);
+            return filepath == nullptr ? "" : filepath;
+        }
+
+        // other filters list their patterns separated by '|'
+        std::vector<std::string> patterns;
+        for (size_t begin = 0; begin < filters.size();) {
+            auto end = std::min(filters.find('|', begin), filters.size());
+            if (end > begin)
+                patterns.emplace_back(filters.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        std::vector<const char *> patternPtrs;
+        for (auto &pattern : patterns)
+            patternPtrs.emplace_back(pattern.c_str());
 
-        return filepath;
+        auto filepath = tinyfd_openFileDialog(title.c_str(), "", patternPtrs.size(), patternPtrs.data(), nullptr, false);
+        return filepath == nullptr ? "" : filepath;
     }
 } // namespace Bess::UI
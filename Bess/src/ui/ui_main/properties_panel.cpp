@@ -1,4 +1,5 @@
 #include "ui/ui_main/properties_panel.h"
+#include "components_manager/command_journal.h"
 #include "components_manager/components_manager.h"
 #include "pages/main_page/main_page_state.h"
 #include "ui/icons/FontAwesomeIcons.h"
@@ -49,8 +50,17 @@ namespace Bess::UI {
             ImGui::PopStyleColor(3);
         }
 
-        if (!deleted)
+        if (!deleted) {
+            // edits are journaled as the saved json before and after them, with
+            // the wires an edit removes, e.g. by dropping slots, in the same step
+            const auto uid = selectedEnt->getId();
+            const auto before = Simulator::ComponentsManager::componentToJson(uid);
+            Simulator::CommandJournal::beginGroup();
             selectedEnt->drawProperties();
+            if (!before.is_null())
+                Simulator::CommandJournal::recordChange(before, Simulator::ComponentsManager::componentToJson(uid));
+            Simulator::CommandJournal::endGroup();
+        }
     end:
         ImGui::End();
     }
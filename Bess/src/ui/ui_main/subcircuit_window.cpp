@@ -0,0 +1,61 @@
+#include "ui/ui_main/subcircuit_window.h"
+#include "components_manager/components_manager.h"
+#include "imgui.h"
+#include "pages/main_page/main_page_state.h"
+#include "ui/m_widgets.h"
+
+#include <stdexcept>
+
+namespace Bess::UI {
+    void SubcircuitWindow::draw() {
+        if (!m_shown)
+            return;
+
+        ImGui::SetNextWindowSize(ImVec2(400, 200), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Save as Subcircuit", &m_shown);
+
+        ImGui::TextWrapped("Selected input and output probes become the ports of the subcircuit, top to bottom.");
+        ImGui::Spacing();
+
+        MWidgets::TextBox("Name", m_name, "Subcircuit name");
+        MWidgets::TextBox("Collection", m_collection);
+
+        if (!m_error.empty())
+            ImGui::TextColored(ImVec4(0.9f, 0.3f, 0.3f, 1.f), "%s", m_error.c_str());
+
+        if (ImGui::Button("Save")) {
+            if (m_name.empty() || m_collection.empty()) {
+                m_error = "Name and collection cannot be empty";
+            } else {
+                try {
+                    auto &ids = Pages::MainPageState::getInstance()->getBulkIds();
+                    Simulator::ComponentsManager::saveAsSubcircuit(ids, m_collection, m_name);
+                    hide();
+                } catch (const std::exception &e) {
+                    m_error = e.what();
+                }
+            }
+        }
+        ImGui::End();
+    }
+
+    void SubcircuitWindow::show() {
+        m_name = "";
+        m_error = "";
+        m_shown = true;
+    }
+
+    void SubcircuitWindow::hide() {
+        m_shown = false;
+    }
+
+    bool SubcircuitWindow::isShown() {
+        return m_shown;
+    }
+
+    bool SubcircuitWindow::m_shown = false;
+    std::string SubcircuitWindow::m_name;
+    std::string SubcircuitWindow::m_collection = "Subcircuits";
+    std::string SubcircuitWindow::m_error;
+
+} // namespace Bess::UI
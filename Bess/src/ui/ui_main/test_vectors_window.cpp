@@ -0,0 +1,124 @@
+#include "ui/ui_main/test_vectors_window.h"
+#include "components/input_probe.h"
+#include "components/output_probe.h"
+#include "components_manager/components_manager.h"
+#include "imgui.h"
+#include "simulator/simulator_engine.h"
+#include "ui/m_widgets.h"
+#include "ui/ui_main/dialogs.h"
+
+#include <stdexcept>
+
+namespace Bess::UI {
+    void TestVectorsWindow::draw() {
+        if (!m_shown)
+            return;
+
+        ImGui::SetNextWindowSize(ImVec2(480, 360), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Test Vectors", &m_shown);
+
+        ImGui::TextWrapped("CSV or JSON vectors name the probes by their label, unlabelled probes by their uid.");
+        ImGui::Spacing();
+
+        MWidgets::TextBox("File", m_path, "CSV or JSON file");
+        ImGui::SameLine();
+        if (ImGui::Button("Browse")) {
+            auto path = Dialogs::showOpenFileDialog("Open Test Vectors", "*.csv|*.json");
+            if (!path.empty())
+                m_path = path;
+        }
+        ImGui::InputInt("Settle ticks", &m_settleTicks);
+        m_settleTicks = std::max(m_settleTicks, 1);
+
+        if (ImGui::Button("Run"))
+            run();
+
+        if (!m_error.empty())
+            ImGui::TextColored(ImVec4(0.9f, 0.3f, 0.3f, 1.f), "%s", m_error.c_str());
+
+        if (m_hasReport) {
+            ImGui::Separator();
+            ImGui::Text("%zu/%zu tests passed, %zu steps", m_report.tests - m_report.failedTests, m_report.tests, m_report.steps);
+
+            if (!m_report.mismatches.empty() && ImGui::BeginTable("Mismatches", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY)) {
+                ImGui::TableSetupColumn("Vector");
+                ImGui::TableSetupColumn("Step");
+                ImGui::TableSetupColumn("Probe");
+                ImGui::TableSetupColumn("Expected / Got");
+                ImGui::TableHeadersRow();
+                for (auto &mismatch : m_report.mismatches) {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", mismatch.line);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", mismatch.step);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", mismatch.label.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%d / %d", mismatch.expected == Simulator::DigitalState::high, mismatch.actual == Simulator::DigitalState::high);
+                }
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
+    }
+
+    void TestVectorsWindow::run() {
+        using namespace Simulator;
+        m_error = "";
+        m_hasReport = false;
+
+        // pin ids are resolved under the netlist lock, new slots may not be published yet
+        std::vector<std::pair<std::string, uuids::uuid>> inputSlots, outputSlots;
+        for (auto &[id, comp] : ComponentsManager::components) {
+            if (comp->getType() == ComponentType::inputProbe) {
+                auto probe = std::static_pointer_cast<Components::InputProbe>(comp);
+                auto label = probe->getLabel().empty() ? uuids::to_string(id) : probe->getLabel();
+                inputSlots.emplace_back(label, probe->getOutputSlot());
+            } else if (comp->getType() == ComponentType::outputProbe) {
+                auto probe = std::static_pointer_cast<Components::OutputProbe>(comp);
+                auto label = probe->getLabel().empty() ? uuids::to_string(id) : probe->getLabel();
+                outputSlots.emplace_back(label, probe->getInputSlot());
+            }
+        }
+
+        try {
+            auto vectors = TestVectorFile::load(m_path);
+            // the runner works on its own copies, the simulation carries on
+            auto runner = Engine::edit([&](const Netlist &netlist) {
+                std::vector<TestRunner::Probe> inputs, outputs;
+                for (auto &[label, slot] : inputSlots)
+                    inputs.push_back({label, netlist.getPinId(slot)});
+                for (auto &[label, slot] : outputSlots)
+                    outputs.push_back({label, netlist.getPinId(slot)});
+                return TestRunner(netlist, inputs, outputs);
+            });
+            runner.setSettleTicks(m_settleTicks);
+            m_report = runner.run(vectors);
+            m_hasReport = true;
+        } catch (const std::exception &e) {
+            m_error = e.what();
+        }
+    }
+
+    void TestVectorsWindow::show() {
+        m_error = "";
+        m_shown = true;
+    }
+
+    void TestVectorsWindow::hide() {
+        m_shown = false;
+    }
+
+    bool TestVectorsWindow::isShown() {
+        return m_shown;
+    }
+
+    bool TestVectorsWindow::m_shown = false;
+    std::string TestVectorsWindow::m_path;
+    int TestVectorsWindow::m_settleTicks = Simulator::TestRunner::defaultSettleTicks;
+    std::string TestVectorsWindow::m_error;
+    bool TestVectorsWindow::m_hasReport = false;
+    Simulator::TestRunner::Report TestVectorsWindow::m_report;
+
+} // namespace Bess::UI
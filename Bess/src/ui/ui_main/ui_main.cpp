@@ -4,20 +4,29 @@
 #include "glad/glad.h"
 #include "imgui.h"
 #include "imgui_internal.h"
+#include <algorithm>
+#include <iostream>
 #include <string>
+#include <thread>
 
 #include "camera.h"
+#include "components/slot.h"
+#include "components_manager/command_journal.h"
 #include "components_manager/components_manager.h"
 #include "pages/main_page/main_page_state.h"
 #include "scene/renderer/gl/gl_wrapper.h"
+#include "simulator/simulator_engine.h"
 #include "ui/icons/FontAwesomeIcons.h"
 #include "ui/icons/MaterialIcons.h"
+#include "ui/ui_main/array_window.h"
 #include "ui/ui_main/component_explorer.h"
 #include "ui/ui_main/dialogs.h"
 #include "ui/ui_main/popups.h"
 #include "ui/ui_main/project_settings_window.h"
 #include "ui/ui_main/properties_panel.h"
 #include "ui/ui_main/settings_window.h"
+#include "ui/ui_main/subcircuit_window.h"
+#include "ui/ui_main/test_vectors_window.h"
 
 namespace Bess::UI {
     UIState UIMain::state{};
@@ -123,9 +132,27 @@ namespace Bess::UI {
 
         if (ImGui::BeginMenu("Edit")) {
 
+            if (ImGui::MenuItem("Undo", "Ctrl+Z", false, Simulator::CommandJournal::canUndo())) {
+                Simulator::CommandJournal::undo();
+            }
+
+            if (ImGui::MenuItem("Redo", "Ctrl+Y", false, Simulator::CommandJournal::canRedo())) {
+                Simulator::CommandJournal::redo();
+            }
+
+            ImGui::Separator();
+
             if (ImGui::MenuItem("Project Settings", "Ctrl+P")) {
                 ProjectSettingsWindow::show();
             }
+
+            if (ImGui::MenuItem("Save Selection as Subcircuit", nullptr, false, !m_pageState->isBulkIdEmpty())) {
+                SubcircuitWindow::show();
+            }
+
+            if (ImGui::MenuItem("Place Array...")) {
+                ArrayWindow::show();
+            }
             ImGui::EndMenu();
         }
 
@@ -136,6 +163,139 @@ namespace Bess::UI {
             if (ImGui::MenuItem(text.c_str(), "Ctrl+Space")) {
                 m_pageState->setSimulationPaused(!m_pageState->isSimulationPaused());
             }
+
+            // turbo drops the real time pacing, clocks keep their simulated frequency
+            bool turbo = Simulator::Engine::getTickRate() <= 0.0;
+            if (ImGui::MenuItem("Turbo", nullptr, turbo)) {
+                Simulator::Engine::setTickRate(turbo ? double(Simulator::ticksPerSecond) : 0.0);
+            }
+
+            // the combinational logic is evaluated level by level on worker threads,
+            // 0 threads uses one per hardware thread
+            static int levelizedThreads = 0;
+            bool levelized = Simulator::Engine::getMode() == Simulator::SimulationMode::levelized;
+            if (ImGui::MenuItem("Levelized Evaluation", nullptr, levelized)) {
+                levelized = !levelized;
+                Simulator::Engine::setMode(levelized ? Simulator::SimulationMode::levelized : Simulator::SimulationMode::eventDriven, levelizedThreads);
+            }
+            int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+            ImGui::SliderInt("Threads", &levelizedThreads, 0, maxThreads, levelizedThreads == 0 ? "auto" : "%d");
+            if (ImGui::IsItemDeactivatedAfterEdit() && levelized)
+                Simulator::Engine::setMode(Simulator::SimulationMode::levelized, levelizedThreads);
+
+            ImGui::Separator();
+            // the gates stay on screen, only the simulation reads the table
+            if (ImGui::MenuItem("Collapse Selection to Lookup Table", nullptr, false, !m_pageState->isBulkIdEmpty())) {
+                std::vector<uuids::uuid> ids;
+                for (auto &id : m_pageState->getBulkIds()) {
+                    auto comp = Simulator::ComponentsManager::getComponent(id);
+                    if (comp && comp->getType() == Simulator::ComponentType::jcomponent)
+                        ids.emplace_back(id);
+                }
+                try {
+                    Simulator::Engine::edit([&ids](Simulator::Netlist &netlist) { netlist.collapse(ids); });
+                } catch (const std::exception &e) {
+                    std::cerr << "[-] " << e.what() << std::endl;
+                }
+            }
+
+            if (ImGui::MenuItem("Expand Lookup Tables")) {
+                Simulator::Engine::edit([](Simulator::Netlist &netlist) {
+                    for (int i = 0; i < netlist.getNodes().size(); i++)
+                        netlist.expand(i);
+                });
+            }
+
+            ImGui::Separator();
+            // oscillating loops are outlined on the canvas
+            if (ImGui::MenuItem("Freeze Oscillating Loops", nullptr, Simulator::Engine::getFreezeOscillations())) {
+                Simulator::Engine::setFreezeOscillations(!Simulator::Engine::getFreezeOscillations());
+            }
+
+            if (ImGui::MenuItem("Release Frozen Loops", nullptr, false, Simulator::Engine::getOscillatingLoopCount() > 0)) {
+                Simulator::Engine::releaseLoops();
+            }
+
+            if (Simulator::Engine::getOscillatingLoopCount() > 0)
+                ImGui::TextDisabled("%zu oscillating loops", Simulator::Engine::getOscillatingLoopCount());
+
+            ImGui::Separator();
+            if (ImGui::MenuItem("Record Trace", nullptr, Simulator::Engine::isTracing())) {
+                Simulator::Engine::setTracing(!Simulator::Engine::isTracing());
+            }
+
+            // outputs of the selected components, the input of output probes
+            if (ImGui::MenuItem("Trace Selected Components", nullptr, false, !m_pageState->isBulkIdEmpty())) {
+                auto &selected = m_pageState->getBulkIds();
+                for (auto &[id, comp] : Simulator::ComponentsManager::components) {
+                    if (comp->getType() != Simulator::ComponentType::inputSlot && comp->getType() != Simulator::ComponentType::outputSlot)
+                        continue;
+                    auto slot = std::static_pointer_cast<Simulator::Components::Slot>(comp);
+                    if (std::ranges::find(selected, slot->getParentId()) == selected.end())
+                        continue;
+                    auto parent = Simulator::ComponentsManager::getComponent(slot->getParentId());
+                    if (slot->getType() == Simulator::ComponentType::inputSlot && parent->getType() != Simulator::ComponentType::outputProbe)
+                        continue;
+                    // not in the simulation yet
+                    if (slot->getPinId() == Simulator::Netlist::invalidId)
+                        continue;
+
+                    auto name = parent->getName();
+                    if (!slot->getLabel().empty())
+                        name += "." + slot->getLabel();
+                    name += "_" + std::to_string(slot->getPinId());
+                    Simulator::Engine::traceSignal({slot->getPinId(), name, slot->getWidth()});
+                }
+            }
+
+            if (ImGui::MenuItem("Clear Traced Signals", nullptr, false, !Simulator::Engine::getTracedSignals().empty())) {
+                Simulator::Engine::clearTracedSignals();
+            }
+
+            if (ImGui::MenuItem("Export Trace as VCD", nullptr, false, Simulator::Engine::isTracing())) {
+                auto path = Dialogs::showSaveFileDialog("Export Trace", "*.vcd");
+                try {
+                    if (!path.empty())
+                        Simulator::Engine::exportTrace(path);
+                } catch (const std::exception &e) {
+                    std::cerr << "[-] " << e.what() << std::endl;
+                }
+            }
+
+            ImGui::Separator();
+            if (ImGui::MenuItem("Run Test Vectors...")) {
+                TestVectorsWindow::show();
+            }
+
+            ImGui::Separator();
+            if (ImGui::MenuItem("Record History", nullptr, Simulator::Engine::isHistoryEnabled())) {
+                Simulator::Engine::setHistoryEnabled(!Simulator::Engine::isHistoryEnabled());
+            }
+
+            if (ImGui::MenuItem("Step Back", nullptr, false, Simulator::Engine::isHistoryEnabled())) {
+                m_pageState->setSimulationPaused(true);
+                Simulator::Engine::stepBack();
+            }
+
+            // the slider follows the simulated time until it is grabbed, the
+            // rewind happens on release
+            if (Simulator::Engine::isHistoryEnabled()) {
+                static Simulator::SimTime scrubTime = 0;
+                static bool scrubbing = false;
+                Simulator::SimTime start = Simulator::Engine::getHistoryStart(), end = Simulator::Engine::getTime();
+                if (!scrubbing)
+                    scrubTime = end;
+                ImGui::SliderScalar("Time (ns)", ImGuiDataType_U64, &scrubTime, &start, &end);
+                scrubbing = ImGui::IsItemActive();
+                if (ImGui::IsItemActivated())
+                    m_pageState->setSimulationPaused(true);
+                if (ImGui::IsItemDeactivatedAfterEdit())
+                    Simulator::Engine::rewindTo(scrubTime);
+            }
+
+            ImGui::Separator();
+            double speed = Simulator::Engine::getAchievedTickRate() / Simulator::ticksPerSecond;
+            ImGui::TextDisabled("Simulated time: %.4gx real time", speed);
             ImGui::EndMenu();
         }
 
@@ -246,6 +406,9 @@ namespace Bess::UI {
     void UIMain::drawExternalWindows() {
         SettingsWindow::draw();
         ProjectSettingsWindow::draw();
+        SubcircuitWindow::draw();
+        ArrayWindow::draw();
+        TestVectorsWindow::draw();
     }
 
     void UIMain::onNewProject() {